@@ -0,0 +1,191 @@
+#include "LuaActorPoolSubsystem.h"
+#include "LuaStateManager.h"
+#include "LuaScriptComponent.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarLuaActorPoolMaxPerClass(
+    TEXT("lua.ActorPool.MaxPerClass"),
+    256,
+    TEXT("Maximum number of inactive actors kept per class by the Lua actor pool, released actors beyond this are destroyed"));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool acquires (reused)"), STAT_LuaPoolReused, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool acquires (spawned)"), STAT_LuaPoolSpawned, STATGROUP_LuaScripting);
+
+void ULuaActorPoolSubsystem::Deinitialize()
+{
+    // Pooled actors belong to the world and go away with it
+    Pools.Empty();
+    PooledActors.Empty();
+
+    Super::Deinitialize();
+}
+
+bool ULuaActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AActor* ULuaActorPoolSubsystem::Acquire(UClass* Class, const FTransform& Transform)
+{
+    if (!Class || !Class->IsChildOf(AActor::StaticClass()))
+    {
+        return nullptr;
+    }
+
+    FPool& Pool = FindOrAddPool(Class);
+    ++Pool.Stats.NumAcquired;
+
+    // Actors may have been destroyed while pooled, skip those
+    while (Pool.FreeActors.Num() > 0)
+    {
+        AActor* Actor = Pool.FreeActors.Pop(EAllowShrinking::No).Get();
+        if (IsValid(Actor))
+        {
+            PooledActors.Remove(Actor);
+
+            Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+            Activate(Actor);
+
+            ++Pool.Stats.NumReused;
+            Pool.Stats.NumFree = Pool.FreeActors.Num();
+            INC_DWORD_STAT(STAT_LuaPoolReused);
+            return Actor;
+        }
+    }
+    Pool.Stats.NumFree = 0;
+
+    INC_DWORD_STAT(STAT_LuaPoolSpawned);
+    return SpawnPooledActor(Class, Transform);
+}
+
+bool ULuaActorPoolSubsystem::Release(AActor* Actor)
+{
+    if (!IsValid(Actor) || Actor->GetWorld() != GetWorld() || PooledActors.Contains(Actor))
+    {
+        return false;
+    }
+
+    FPool& Pool = FindOrAddPool(Actor->GetClass());
+    ++Pool.Stats.NumReleased;
+
+    if (Pool.FreeActors.Num() >= CVarLuaActorPoolMaxPerClass.GetValueOnGameThread())
+    {
+        Actor->Destroy();
+        return true;
+    }
+
+    // Marked as pooled first, handlers of the end-overlap events fired by Deactivate may try to release it again; it
+    // is only handed out once fully deactivated
+    PooledActors.Add(Actor);
+    Deactivate(Actor);
+    Pool.FreeActors.Add(Actor);
+    Pool.Stats.NumFree = Pool.FreeActors.Num();
+    return true;
+}
+
+int32 ULuaActorPoolSubsystem::Prewarm(UClass* Class, int32 Count)
+{
+    if (!Class || !Class->IsChildOf(AActor::StaticClass()))
+    {
+        return 0;
+    }
+
+    const int32 Target = FMath::Min(Count, CVarLuaActorPoolMaxPerClass.GetValueOnGameThread());
+
+    int32 NumSpawned = 0;
+    FPool& Pool = FindOrAddPool(Class);
+    while (Pool.FreeActors.Num() < Target)
+    {
+        AActor* Actor = SpawnPooledActor(Class, FTransform::Identity);
+        if (!Actor)
+        {
+            break;
+        }
+
+        PooledActors.Add(Actor);
+        Deactivate(Actor);
+        Pool.FreeActors.Add(Actor);
+        Pool.Stats.NumFree = Pool.FreeActors.Num();
+        ++NumSpawned;
+    }
+
+    return NumSpawned;
+}
+
+FLuaActorPoolStats ULuaActorPoolSubsystem::GetStats(UClass* Class) const
+{
+    const TUniquePtr<FPool>* Pool = Pools.Find(Class);
+    return Pool ? (*Pool)->Stats : FLuaActorPoolStats();
+}
+
+ULuaActorPoolSubsystem::FPool& ULuaActorPoolSubsystem::FindOrAddPool(UClass* Class)
+{
+    TUniquePtr<FPool>& Pool = Pools.FindOrAdd(Class);
+    if (!Pool)
+    {
+        Pool = MakeUnique<FPool>();
+    }
+    return *Pool;
+}
+
+AActor* ULuaActorPoolSubsystem::SpawnPooledActor(UClass* Class, const FTransform& Transform)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    AActor* Actor = GetWorld()->SpawnActor<AActor>(Class, Transform, SpawnParams);
+    if (Actor)
+    {
+        ++FindOrAddPool(Class).Stats.NumSpawned;
+    }
+    return Actor;
+}
+
+void ULuaActorPoolSubsystem::Deactivate(AActor* Actor)
+{
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+
+    Actor->ForEachComponent<UActorComponent>(false, [](UActorComponent* Component)
+    {
+        Component->SetComponentTickEnabled(false);
+
+        // Stop any motion left over from the previous use
+        if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+        {
+            if (Primitive->IsSimulatingPhysics())
+            {
+                Primitive->SetPhysicsLinearVelocity(FVector::ZeroVector);
+                Primitive->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+            }
+        }
+
+        Component->Deactivate();
+    });
+}
+
+void ULuaActorPoolSubsystem::Activate(AActor* Actor)
+{
+    Actor->ForEachComponent<UActorComponent>(false, [](UActorComponent* Component)
+    {
+        // Only bring back components that activate on their own when spawned
+        if (Component->bAutoActivate)
+        {
+            Component->Activate(true);
+        }
+
+        // Script components enable their tick when the script runs rather than at spawn (batched or not)
+        if (Component->PrimaryComponentTick.bStartWithTickEnabled || Component->IsA<ULuaScriptComponent>())
+        {
+            Component->SetComponentTickEnabled(true);
+        }
+    });
+
+    Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+    Actor->SetActorEnableCollision(true);
+    Actor->SetActorHiddenInGame(false);
+}
\ No newline at end of file
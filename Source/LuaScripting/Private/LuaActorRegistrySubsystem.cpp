@@ -0,0 +1,384 @@
+#include "LuaActorRegistrySubsystem.h"
+#include "LuaStateManager.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/StringBuilder.h"
+
+DECLARE_CYCLE_STAT(TEXT("Actor registry build"), STAT_LuaActorRegistryBuild, STATGROUP_LuaScripting);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered actors"), STAT_LuaRegisteredActors, STATGROUP_LuaScripting);
+
+void ULuaActorRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UWorld* World = GetWorld();
+    ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ULuaActorRegistrySubsystem::OnActorSpawned));
+    ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ULuaActorRegistrySubsystem::OnActorDestroyed));
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ULuaActorRegistrySubsystem::OnLevelAddedToWorld);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ULuaActorRegistrySubsystem::OnLevelRemovedFromWorld);
+#if WITH_EDITOR
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddUObject(this, &ULuaActorRegistrySubsystem::OnActorLabelChanged);
+#endif
+}
+
+void ULuaActorRegistrySubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+#if WITH_EDITOR
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+#endif
+
+    ResetIndex();
+
+    Super::Deinitialize();
+}
+
+bool ULuaActorRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+AActor* ULuaActorRegistrySubsystem::FindActorByName(FName Name, const TCHAR* ExactName)
+{
+    if (Name.IsNone())
+    {
+        return nullptr;
+    }
+
+    EnsureBuilt();
+
+    // Entries are validated against the live actor, object renames are not broadcast at runtime
+    for (auto It = ActorsByName.CreateConstKeyIterator(Name); It; ++It)
+    {
+        AActor* Actor = It.Value().Get();
+        if (IsValid(Actor) && Actor->GetFName() == Name)
+        {
+            if (!ExactName)
+            {
+                return Actor;
+            }
+
+            TStringBuilder<NAME_SIZE> ActorName;
+            Actor->GetFName().AppendString(ActorName);
+            if (FCString::Strcmp(ActorName.ToString(), ExactName) == 0)
+            {
+                return Actor;
+            }
+        }
+    }
+
+    for (auto It = ActorsByLabel.CreateConstKeyIterator(Name); It; ++It)
+    {
+        AActor* Actor = It.Value().Get();
+#if WITH_EDITOR
+        if (IsValid(Actor) && (!ExactName || Actor->GetActorLabel(false).Equals(ExactName, ESearchCase::CaseSensitive)))
+#else
+        if (IsValid(Actor))
+#endif
+        {
+            return Actor;
+        }
+    }
+
+    return nullptr;
+}
+
+void ULuaActorRegistrySubsystem::FindActorsOfClass(UClass* Class, bool bIncludeDerived, TArray<AActor*>& OutActors)
+{
+    if (!Class)
+    {
+        return;
+    }
+
+    EnsureBuilt();
+
+    // The class index is keyed by exact class, a world holds few distinct classes so walking the keys is cheap
+    for (const TPair<TObjectKey<UClass>, TSet<TWeakObjectPtr<AActor>>>& Pair : ActorsByClass)
+    {
+        UClass* ActorClass = Pair.Key.ResolveObjectPtr();
+        if (!ActorClass || (bIncludeDerived ? !ActorClass->IsChildOf(Class) : ActorClass != Class))
+        {
+            continue;
+        }
+
+        OutActors.Reserve(OutActors.Num() + Pair.Value.Num());
+        for (const TWeakObjectPtr<AActor>& WeakActor : Pair.Value)
+        {
+            AActor* Actor = WeakActor.Get();
+            if (IsValid(Actor))
+            {
+                OutActors.Add(Actor);
+            }
+        }
+    }
+}
+
+void ULuaActorRegistrySubsystem::FindActorsWithTag(FName Tag, TArray<AActor*>& OutActors)
+{
+    if (Tag.IsNone())
+    {
+        return;
+    }
+
+    EnsureBuilt();
+
+    const TSet<TWeakObjectPtr<AActor>>* TagActors = ActorsByTag.Find(Tag);
+    if (!TagActors)
+    {
+        return;
+    }
+
+    // Entries are validated against the live tags, native code may edit them without telling the registry
+    OutActors.Reserve(OutActors.Num() + TagActors->Num());
+    for (const TWeakObjectPtr<AActor>& WeakActor : *TagActors)
+    {
+        AActor* Actor = WeakActor.Get();
+        if (IsValid(Actor) && Actor->Tags.Contains(Tag))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+bool ULuaActorRegistrySubsystem::AddActorTag(AActor* Actor, FName Tag)
+{
+    if (!Actor || Tag.IsNone() || Actor->Tags.Contains(Tag))
+    {
+        return false;
+    }
+
+    Actor->Tags.Add(Tag);
+
+    if (FEntry* Entry = Entries.Find(Actor))
+    {
+        if (!Entry->Tags.Contains(Tag))
+        {
+            Entry->Tags.Add(Tag);
+            ActorsByTag.FindOrAdd(Tag).Add(Actor);
+        }
+    }
+
+    return true;
+}
+
+bool ULuaActorRegistrySubsystem::RemoveActorTag(AActor* Actor, FName Tag)
+{
+    if (!Actor || Actor->Tags.Remove(Tag) == 0)
+    {
+        return false;
+    }
+
+    if (FEntry* Entry = Entries.Find(Actor))
+    {
+        RemoveTagEntries(Actor, *Entry);
+        AddTagEntries(Actor, *Entry);
+    }
+
+    return true;
+}
+
+void ULuaActorRegistrySubsystem::RefreshActorTags(AActor* Actor)
+{
+    if (FEntry* Entry = Actor ? Entries.Find(Actor) : nullptr)
+    {
+        RemoveTagEntries(Actor, *Entry);
+        AddTagEntries(Actor, *Entry);
+    }
+}
+
+void ULuaActorRegistrySubsystem::EnsureBuilt()
+{
+    if (bBuilt)
+    {
+        return;
+    }
+
+    // Parallel ticks build the index before their scripts run
+    check(IsInGameThread());
+    SCOPE_CYCLE_COUNTER(STAT_LuaActorRegistryBuild);
+
+    bBuilt = true;
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        AddActor(*It);
+    }
+
+    UE_LOG(LogLuaScripting, Verbose, TEXT("Actor registry built for %s (%d actors)"), *GetWorld()->GetName(), Entries.Num());
+}
+
+void ULuaActorRegistrySubsystem::ResetIndex()
+{
+    DEC_DWORD_STAT_BY(STAT_LuaRegisteredActors, Entries.Num());
+
+    Entries.Empty();
+    ActorsByName.Empty();
+    ActorsByLabel.Empty();
+    ActorsByClass.Empty();
+    ActorsByTag.Empty();
+    bBuilt = false;
+}
+
+void ULuaActorRegistrySubsystem::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || Entries.Contains(Actor))
+    {
+        return;
+    }
+
+    FEntry Entry;
+    Entry.Name = Actor->GetFName();
+    Entry.Class = Actor->GetClass();
+#if WITH_EDITOR
+    // Labels only exist in editor builds; don't create a default label just to index it. A label differing from
+    // the name only by case is indexed too, so it can be found case-sensitively
+    const FString& Label = Actor->GetActorLabel(false);
+    if (!Label.IsEmpty())
+    {
+        Entry.Label = FName(*Label);
+    }
+#endif
+
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    ActorsByName.Add(Entry.Name, WeakActor);
+    if (!Entry.Label.IsNone())
+    {
+        ActorsByLabel.Add(Entry.Label, WeakActor);
+    }
+    ActorsByClass.FindOrAdd(Entry.Class).Add(WeakActor);
+
+    AddTagEntries(Actor, Entries.Add(Actor, Entry));
+    INC_DWORD_STAT(STAT_LuaRegisteredActors);
+}
+
+void ULuaActorRegistrySubsystem::RemoveActor(AActor* Actor)
+{
+    FEntry Entry;
+    if (!Entries.RemoveAndCopyValue(Actor, Entry))
+    {
+        return;
+    }
+
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    ActorsByName.RemoveSingle(Entry.Name, WeakActor);
+    if (!Entry.Label.IsNone())
+    {
+        ActorsByLabel.RemoveSingle(Entry.Label, WeakActor);
+    }
+
+    if (TSet<TWeakObjectPtr<AActor>>* ClassActors = ActorsByClass.Find(Entry.Class))
+    {
+        ClassActors->Remove(WeakActor);
+        if (ClassActors->Num() == 0)
+        {
+            ActorsByClass.Remove(Entry.Class);
+        }
+    }
+
+    RemoveTagEntries(Actor, Entry);
+
+    DEC_DWORD_STAT(STAT_LuaRegisteredActors);
+}
+
+void ULuaActorRegistrySubsystem::AddTagEntries(AActor* Actor, FEntry& Entry)
+{
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    for (const FName& Tag : Actor->Tags)
+    {
+        if (!Tag.IsNone() && !Entry.Tags.Contains(Tag))
+        {
+            Entry.Tags.Add(Tag);
+            ActorsByTag.FindOrAdd(Tag).Add(WeakActor);
+        }
+    }
+}
+
+void ULuaActorRegistrySubsystem::RemoveTagEntries(AActor* Actor, FEntry& Entry)
+{
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    for (const FName& Tag : Entry.Tags)
+    {
+        if (TSet<TWeakObjectPtr<AActor>>* TagActors = ActorsByTag.Find(Tag))
+        {
+            TagActors->Remove(WeakActor);
+            if (TagActors->Num() == 0)
+            {
+                ActorsByTag.Remove(Tag);
+            }
+        }
+    }
+    Entry.Tags.Reset();
+}
+
+void ULuaActorRegistrySubsystem::OnActorSpawned(AActor* Actor)
+{
+    if (bBuilt)
+    {
+        AddActor(Actor);
+    }
+}
+
+void ULuaActorRegistrySubsystem::OnActorDestroyed(AActor* Actor)
+{
+    if (bBuilt)
+    {
+        RemoveActor(Actor);
+    }
+}
+
+void ULuaActorRegistrySubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* InWorld)
+{
+    if (!bBuilt || InWorld != GetWorld() || !Level)
+    {
+        return;
+    }
+
+    // Actors of streamed-in levels are not reported as spawned
+    for (AActor* Actor : Level->Actors)
+    {
+        AddActor(Actor);
+    }
+}
+
+void ULuaActorRegistrySubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld)
+{
+    if (!bBuilt || InWorld != GetWorld())
+    {
+        return;
+    }
+
+    if (!Level)
+    {
+        // The whole world is being torn down, rebuild from scratch if it is queried again
+        ResetIndex();
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            RemoveActor(Actor);
+        }
+    }
+}
+
+#if WITH_EDITOR
+void ULuaActorRegistrySubsystem::OnActorLabelChanged(AActor* Actor)
+{
+    if (bBuilt && Actor && Actor->GetWorld() == GetWorld() && Entries.Contains(Actor))
+    {
+        // Re-index under the new label
+        RemoveActor(Actor);
+        AddActor(Actor);
+    }
+}
+#endif
\ No newline at end of file
@@ -1,10 +1,28 @@
 #include "LuaBinding.h"
 #include "LuaStateManager.h"
+#include "LuaObjectHandle.h"
+#include "LuaValueTypes.h"
+#include "LuaMathKernels.h"
+#include "LuaBuffer.h"
+#include "LuaLogSink.h"
+#include "LuaStateContext.h"
+#include "LuaActorRegistrySubsystem.h"
+#include "LuaClassCache.h"
+#include "LuaActorPoolSubsystem.h"
+#include "LuaSpawnScheduler.h"
+#include "LuaSpatialIndexSubsystem.h"
+#include "LuaStringBridge.h"
+#include "LuaEventQueueSubsystem.h"
+#include "LuaDelegateThunk.h"
+#include "LuaBind.h"
+#include "LuaContainerProxy.h"
+#include "LuaCommandBuffer.h"
 #include "GameFramework/Actor.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "UObject/UObjectHash.h"
 #include "UObject/UObjectIterator.h"
+#include "UObject/UnrealType.h"
 #include "EngineUtils.h"
 
 // Include Lua headers
@@ -16,6 +34,155 @@ extern "C" {
 
 DEFINE_LOG_CATEGORY(LogLuaScripting)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("GetWorld (context)"), STAT_LuaGetWorldContext, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GetWorld (world context scan)"), STAT_LuaGetWorldFallback, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("FindActor"), STAT_LuaFindActor, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("FindActorsOfClass"), STAT_LuaFindActorsOfClass, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("FindByTag"), STAT_LuaFindByTag, STATGROUP_LuaScripting);
+
+// Registry name of the metatable shared by all UObject handles
+static const char* UObjectMetatableName = "UObject";
+
+// Registry name of the metatable of multicast delegate proxies
+static const char* MulticastDelegateMetatableName = "UMulticastDelegate";
+
+// Userdata behind a multicast delegate proxy
+struct FLuaMulticastDelegateProxy
+{
+    FLuaObjectHandle Object;
+    FMulticastDelegateProperty* Property;
+};
+
+namespace LuaBinding
+{
+    // Methods that need more than a direct call, bound through LuaBind like the member functions below. Methods
+    // that change the actor are recorded when called from a parallel tick (FLuaCommandBuffer)
+
+    bool SetActorLocation(AActor* Actor, FVector NewLocation)
+    {
+        return Actor->SetActorLocation(NewLocation);
+    }
+
+    bool SetActorRotation(AActor* Actor, FRotator NewRotation)
+    {
+        return Actor->SetActorRotation(NewRotation);
+    }
+
+    void AddTag(AActor* Actor, FName Tag)
+    {
+        UWorld* ActorWorld = Actor->GetWorld();
+        if (ULuaActorRegistrySubsystem* Registry = ActorWorld ? ActorWorld->GetSubsystem<ULuaActorRegistrySubsystem>() : nullptr)
+        {
+            // Keeps UE.Actor.FindByTag up to date
+            Registry->AddActorTag(Actor, Tag);
+        }
+        else
+        {
+            Actor->Tags.AddUnique(Tag);
+        }
+    }
+
+    void RemoveTag(AActor* Actor, FName Tag)
+    {
+        UWorld* ActorWorld = Actor->GetWorld();
+        if (ULuaActorRegistrySubsystem* Registry = ActorWorld ? ActorWorld->GetSubsystem<ULuaActorRegistrySubsystem>() : nullptr)
+        {
+            Registry->RemoveActorTag(Actor, Tag);
+        }
+        else
+        {
+            Actor->Tags.Remove(Tag);
+        }
+    }
+
+    int32 GetNumTags(AActor* Actor)
+    {
+        return Actor->Tags.Num();
+    }
+
+    bool CanEverTick(AActor* Actor)
+    {
+        return Actor->PrimaryActorTick.bCanEverTick;
+    }
+
+    AActor* GetOwner(UActorComponent* Component)
+    {
+        return Component->GetOwner();
+    }
+
+    // Names are returned as FNames, their Lua strings are cached
+    FName GetName(UObject* Object)
+    {
+        return Object->GetFName();
+    }
+
+    FName GetClass(UObject* Object)
+    {
+        return Object->GetClass()->GetFName();
+    }
+
+    // Written by hand, the class name goes straight from the Lua string to the class cache without an FString
+    int IsA(lua_State* L)
+    {
+        UObject* Object = LuaBindTypes::CheckSelf<UObject>(L);
+
+        // Unknown classes are simply not matched
+        UClass* ClassToCheck = FLuaClassCache::Get().FindClass(FLuaStringBridge::ToTCHAR(L, 2));
+        lua_pushboolean(L, ClassToCheck && Object->IsA(ClassToCheck));
+        return 1;
+    }
+
+    const luaL_Reg ActorMethods[] =
+    {
+        { "GetActorLocation", LuaBind<&AActor::GetActorLocation>() },
+        { "SetActorLocation", FLuaCommandBuffer::Deferrable<LuaBind<&SetActorLocation>()> },
+        { "GetActorRotation", LuaBind<&AActor::GetActorRotation>() },
+        { "SetActorRotation", FLuaCommandBuffer::Deferrable<LuaBind<&SetActorRotation>()> },
+        { "GetActorScale3D", LuaBind<&AActor::GetActorScale3D>() },
+        { "SetActorScale3D", FLuaCommandBuffer::Deferrable<LuaBind<&AActor::SetActorScale3D>()> },
+        { "SetActorHiddenInGame", FLuaCommandBuffer::Deferrable<LuaBind<&AActor::SetActorHiddenInGame>()> },
+        { "IsHidden", LuaBind<&AActor::IsHidden>() },
+        { "HasTag", LuaBind<&AActor::ActorHasTag>() },
+        { "AddTag", FLuaCommandBuffer::Deferrable<LuaBind<&AddTag>()> },
+        { "RemoveTag", FLuaCommandBuffer::Deferrable<LuaBind<&RemoveTag>()> },
+        { "GetNumTags", LuaBind<&GetNumTags>() },
+        { "GetLifeSpan", LuaBind<&AActor::GetLifeSpan>() },
+        { "SetLifeSpan", FLuaCommandBuffer::Deferrable<LuaBind<&AActor::SetLifeSpan>()> },
+        { "CanEverTick", LuaBind<&CanEverTick>() },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg ComponentMethods[] =
+    {
+        { "GetOwner", LuaBind<&GetOwner>() },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg ObjectMethods[] =
+    {
+        { "GetName", LuaBind<&GetName>() },
+        { "GetClass", LuaBind<&GetClass>() },
+        { "IsA", IsA },
+        { nullptr, nullptr }
+    };
+
+    // Method tables by class, most derived first; each becomes an upvalue of the __index metamethod
+    struct FMethodTable
+    {
+        UClass* (*StaticClass)();
+        const luaL_Reg* Methods;
+    };
+
+    const FMethodTable MethodTables[] =
+    {
+        { &AActor::StaticClass, ActorMethods },
+        { &UActorComponent::StaticClass, ComponentMethods },
+        { &UObject::StaticClass, ObjectMethods },
+    };
+
+    constexpr int NumMethodTables = UE_ARRAY_COUNT(MethodTables);
+}
+
 void FLuaBinding::RegisterCoreFunctions(lua_State* L)
 {
     // Create the UE namespace table
@@ -35,6 +202,12 @@ void FLuaBinding::RegisterCoreFunctions(lua_State* L)
     // Set the UE table as a global
     lua_setglobal(L, "UE");
 
+    // Register the typed numeric buffer type
+    FLuaBuffer::Register(L);
+
+    // Register class lookup and preloading
+    FLuaClassCache::Register(L);
+
     // Register the event system
     RegisterEventSystem(L);
 
@@ -49,8 +222,8 @@ void FLuaBinding::RegisterMathFunctions(lua_State* L)
     // Create the math table
     lua_newtable(L);
 
-    // Add math functions here
-    // Example: Vector operations, rotations, transforms, etc.
+    // Register the batch vector kernels
+    FLuaMathKernels::Register(L);
 
     // Set the math table in the UE namespace
     lua_setfield(L, -2, "Math");
@@ -58,6 +231,9 @@ void FLuaBinding::RegisterMathFunctions(lua_State* L)
     // Pop the UE table
     lua_pop(L, 1);
 
+    // Register the FVector/FRotator/FQuat/FTransform value types and their constructors
+    FLuaValueTypes::Register(L);
+
     UE_LOG(LogLuaScripting, Log, TEXT("Math functions registered"));
 }
 
@@ -96,16 +272,52 @@ void FLuaBinding::RegisterActorFunctions(lua_State* L)
     // Create the Actor table
     lua_newtable(L);
 
-    // Register actor functions
+    // Register actor functions, the ones changing the world are recorded when called from a parallel tick
     lua_pushcfunction(L, Lua_FindActor);
     lua_setfield(L, -2, "FindActor");
 
-    lua_pushcfunction(L, Lua_SpawnActor);
+    lua_pushcfunction(L, Lua_FindActorsOfClass);
+    lua_setfield(L, -2, "FindActorsOfClass");
+
+    lua_pushcfunction(L, Lua_FindByTag);
+    lua_setfield(L, -2, "FindByTag");
+
+    // Functions returning actors or counts can't be recorded from a parallel tick, their results are needed right away
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_SpawnActor>);
     lua_setfield(L, -2, "SpawnActor");
 
-    lua_pushcfunction(L, Lua_DestroyActor);
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_DestroyActor>);
     lua_setfield(L, -2, "DestroyActor");
 
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_SpawnMany>);
+    lua_setfield(L, -2, "SpawnMany");
+
+    // Register actor pooling functions
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_Acquire>);
+    lua_setfield(L, -2, "Acquire");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_Release>);
+    lua_setfield(L, -2, "Release");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_Prewarm>);
+    lua_setfield(L, -2, "Prewarm");
+
+    lua_pushcfunction(L, Lua_GetPoolStats);
+    lua_setfield(L, -2, "GetPoolStats");
+
+    // Register batched transform functions
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_SetLocations>);
+    lua_setfield(L, -2, "SetLocations");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_SetRotations>);
+    lua_setfield(L, -2, "SetRotations");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_SetScales>);
+    lua_setfield(L, -2, "SetScales");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_SetTransforms>);
+    lua_setfield(L, -2, "SetTransforms");
+
     // Set the Actor table in the UE namespace
     lua_setfield(L, -2, "Actor");
 
@@ -115,43 +327,62 @@ void FLuaBinding::RegisterActorFunctions(lua_State* L)
     UE_LOG(LogLuaScripting, Log, TEXT("Actor functions registered"));
 }
 
-UWorld* FLuaBinding::GetWorld(lua_State* L)
+void FLuaBinding::RegisterWorldFunctions(lua_State* L)
 {
-    // Try to get the world from the global "self" actor if available
-    lua_getglobal(L, "self");
-    if (!lua_isnil(L, -1))
-    {
-        AActor* SelfActor = Cast<AActor>(GetUObject(L, -1));
-        lua_pop(L, 1);
+    // Get the UE namespace table
+    lua_getglobal(L, "UE");
 
-        if (SelfActor)
-        {
-            return SelfActor->GetWorld();
-        }
-    }
-    else
-    {
-        lua_pop(L, 1);
-    }
+    // Create the World table
+    lua_newtable(L);
 
-    // Try to get the world from the component if available
-    lua_getglobal(L, "component");
-    if (!lua_isnil(L, -1))
-    {
-        UActorComponent* Component = Cast<UActorComponent>(GetUObject(L, -1));
-        lua_pop(L, 1);
+    // Register spatial index opt-in functions; Track and Untrack are recorded when called from a parallel tick, the
+    // class and tag functions return the number of tracked actors and are game thread only
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_TrackClass>);
+    lua_setfield(L, -2, "TrackClass");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_TrackTag>);
+    lua_setfield(L, -2, "TrackTag");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_Track>);
+    lua_setfield(L, -2, "Track");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_Untrack>);
+    lua_setfield(L, -2, "Untrack");
+
+    // Register spatial queries
+    lua_pushcfunction(L, Lua_QueryRadius);
+    lua_setfield(L, -2, "QueryRadius");
+
+    lua_pushcfunction(L, Lua_QueryBox);
+    lua_setfield(L, -2, "QueryBox");
+
+    lua_pushcfunction(L, Lua_QueryNearest);
+    lua_setfield(L, -2, "QueryNearest");
+
+    // Set the World table in the UE namespace
+    lua_setfield(L, -2, "World");
+
+    // Pop the UE table
+    lua_pop(L, 1);
+
+    UE_LOG(LogLuaScripting, Log, TEXT("World functions registered"));
+}
 
-        if (Component)
+UWorld* FLuaBinding::GetWorld(lua_State* L)
+{
+    // The owning component's world is cached in the state's native context
+    if (FLuaStateContext* Context = FLuaStateContext::Get(L))
+    {
+        if (UWorld* World = Context->World.Get())
         {
-            return Component->GetWorld();
+            INC_DWORD_STAT(STAT_LuaGetWorldContext);
+            return World;
         }
     }
-    else
-    {
-        lua_pop(L, 1);
-    }
 
-    // As a last resort, try to get the game world
+    INC_DWORD_STAT(STAT_LuaGetWorldFallback);
+
+    // As a last resort (e.g. the shared main state), try to get the game world
     for (const FWorldContext& Context : GEngine->GetWorldContexts())
     {
         if (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE)
@@ -171,22 +402,31 @@ void FLuaBinding::PushUObject(lua_State* L, UObject* Object)
         return;
     }
 
-    // Create a userdata to hold the UObject pointer
-    void** UserData = (void**)lua_newuserdata(L, sizeof(void*));
-    *UserData = Object;
+    // Create a userdata holding an index/serial handle rather than the raw pointer
+    FLuaObjectHandle* Handle = static_cast<FLuaObjectHandle*>(lua_newuserdatauv(L, sizeof(FLuaObjectHandle), 0));
+    new (Handle) FLuaObjectHandle(Object);
 
     // Create or get the metatable for UObject
-    if (luaL_newmetatable(L, "UObject"))
+    if (luaL_newmetatable(L, UObjectMetatableName))
     {
         // First time creation
-        // Setup the __index metamethod for method dispatching
-        lua_pushcfunction(L, UObjectIndex);
+        // Setup the __index metamethod for method dispatching, with one method table per class as upvalues
+        for (const LuaBinding::FMethodTable& MethodTable : LuaBinding::MethodTables)
+        {
+            lua_newtable(L);
+            luaL_setfuncs(L, MethodTable.Methods, 0);
+        }
+        lua_pushcclosure(L, UObjectIndex, LuaBinding::NumMethodTables);
         lua_setfield(L, -2, "__index");
 
         // Setup __tostring metamethod to display UObject info
         lua_pushcfunction(L, UObjectToString);
         lua_setfield(L, -2, "__tostring");
 
+        // Two handles are equal when they refer to the same object slot and serial
+        lua_pushcfunction(L, UObjectEquals);
+        lua_setfield(L, -2, "__eq");
+
         // Add garbage collection method
         lua_pushcfunction(L, [](lua_State* L) {
             // UObjects are managed by Unreal, not Lua, so we don't need to do anything here
@@ -201,20 +441,15 @@ void FLuaBinding::PushUObject(lua_State* L, UObject* Object)
 
 UObject* FLuaBinding::GetUObject(lua_State* L, int Index)
 {
-    if (!lua_isuserdata(L, Index))
+    // Only accept userdata carrying our metatable, anything else is not a UObject
+    const FLuaObjectHandle* Handle = static_cast<const FLuaObjectHandle*>(luaL_testudata(L, Index, UObjectMetatableName));
+    if (!Handle)
     {
         return nullptr;
     }
 
-    // Check if we have a valid userdata with our metatable
-    void* UserData = lua_touserdata(L, Index);
-    if (!UserData)
-    {
-        return nullptr;
-    }
-
-    // We should validate this is actually a UObject, but for simplicity we'll just cast
-    return static_cast<UObject*>(*(void**)UserData);
+    // Resolves to nullptr if the object has been destroyed since it was pushed
+    return Handle->Resolve();
 }
 
 void FLuaBinding::SetGlobalUObject(lua_State* L, const char* Name, UObject* Object)
@@ -241,8 +476,40 @@ int FLuaBinding::UObjectIndex(lua_State* L)
         return luaL_error(L, "Invalid method name in __index");
     }
 
-    // Check if this is a known method
-    return DispatchUObjectMethod(L, Object, MethodName);
+    // Methods are returned as functions and called by Lua with the object as first argument (object:Method(...))
+    for (int TableIndex = 0; TableIndex < LuaBinding::NumMethodTables; ++TableIndex)
+    {
+        if (Object->IsA(LuaBinding::MethodTables[TableIndex].StaticClass()))
+        {
+            lua_pushvalue(L, 2);
+            if (lua_rawget(L, lua_upvalueindex(TableIndex + 1)) != LUA_TNIL)
+            {
+                return 1;
+            }
+            lua_pop(L, 1);
+        }
+    }
+
+    if (FProperty* Property = FindFProperty<FProperty>(Object->GetClass(), FLuaStringBridge::FindName(L, 2)))
+    {
+        // Multicast delegates (OnActorBeginOverlap, OnTakeAnyDamage, ...) can be bound to Lua functions
+        if (FMulticastDelegateProperty* DelegateProperty = CastField<FMulticastDelegateProperty>(Property))
+        {
+            PushMulticastDelegate(L, Object, DelegateProperty);
+            return 1;
+        }
+
+        // Containers (Tags, ...) are proxies over the object's memory instead of copies
+        if (FLuaContainerProxy::IsContainer(Property))
+        {
+            FLuaContainerProxy::Push(L, Object, Property);
+            return 1;
+        }
+    }
+
+    // Return nil instead of raising an error to be more forgiving in scripts
+    lua_pushnil(L);
+    return 1;
 }
 
 int FLuaBinding::UObjectToString(lua_State* L)
@@ -255,8 +522,10 @@ int FLuaBinding::UObjectToString(lua_State* L)
         // Add class name if available
         if (Object->GetClass())
         {
-            lua_pushfstring(L, " (%s)", TCHAR_TO_UTF8(*Object->GetClass()->GetName()));
-            lua_concat(L, 2);
+            lua_pushliteral(L, " (");
+            FLuaStringBridge::PushName(L, Object->GetClass()->GetFName());
+            lua_pushliteral(L, ")");
+            lua_concat(L, 4);
         }
     }
     else
@@ -267,459 +536,265 @@ int FLuaBinding::UObjectToString(lua_State* L)
     return 1;
 }
 
-int FLuaBinding::DispatchUObjectMethod(lua_State* L, UObject* Object, const char* MethodName)
+int FLuaBinding::UObjectEquals(lua_State* L)
+{
+    const FLuaObjectHandle* A = static_cast<const FLuaObjectHandle*>(luaL_testudata(L, 1, UObjectMetatableName));
+    const FLuaObjectHandle* B = static_cast<const FLuaObjectHandle*>(luaL_testudata(L, 2, UObjectMetatableName));
+
+    lua_pushboolean(L, A && B && *A == *B);
+    return 1;
+}
+
+void FLuaBinding::PushMulticastDelegate(lua_State* L, UObject* Object, FMulticastDelegateProperty* Property)
 {
-    FString MethodString = UTF8_TO_TCHAR(MethodName);
+    FLuaMulticastDelegateProxy* Proxy = static_cast<FLuaMulticastDelegateProxy*>(lua_newuserdatauv(L, sizeof(FLuaMulticastDelegateProxy), 0));
+    new (Proxy) FLuaMulticastDelegateProxy{ FLuaObjectHandle(Object), Property };
 
-    // Component methods
-    UActorComponent* Component = Cast<UActorComponent>(Object);
-    if (Component)
+    if (luaL_newmetatable(L, MulticastDelegateMetatableName))
     {
-        // Methods for all UActorComponent types
-        if (MethodString == TEXT("GetOwner"))
-        {
-            AActor* Owner = Component->GetOwner();
-            PushUObject(L, Owner);
-            return 1;
-        }
+        // Methods are looked up in the metatable itself. Add returns the handle to remove the binding with, so it
+        // can't be recorded in a parallel tick
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -2, "__index");
+
+        lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_DelegateAdd>);
+        lua_setfield(L, -2, "Add");
+
+        lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_DelegateRemove>);
+        lua_setfield(L, -2, "Remove");
+
+        lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_DelegateClear>);
+        lua_setfield(L, -2, "Clear");
     }
+    lua_setmetatable(L, -2);
+}
 
-    // Handle common Actor methods
-    AActor* Actor = Cast<AActor>(Object);
-    if (Actor)
+int FLuaBinding::Lua_DelegateAdd(lua_State* L)
+{
+    const FLuaMulticastDelegateProxy* Proxy = static_cast<const FLuaMulticastDelegateProxy*>(luaL_checkudata(L, 1, MulticastDelegateMetatableName));
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    UObject* Object = Proxy->Object.Resolve();
+    if (!Object)
     {
-        // Location methods
-        if (MethodString == TEXT("GetActorLocation"))
-        {
-            const FVector& Location = Actor->GetActorLocation();
-            PushVector(L, Location);
-            return 1;
-        }
-        else if (MethodString == TEXT("SetActorLocation"))
-        {
-            // Expect a table with X, Y, Z
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "SetActorLocation requires a vector parameter");
-            }
+        return luaL_error(L, "Cannot bind to a delegate of a destroyed object");
+    }
 
-            FVector NewLocation = GetVector(L, 3);
-            bool bSuccess = Actor->SetActorLocation(NewLocation);
-            lua_pushboolean(L, bSuccess);
-            return 1;
-        }
+    lua_pushinteger(L, ULuaDelegateThunk::Bind(L, Object, Proxy->Property, 2));
+    return 1;
+}
 
-        // Rotation methods
-        else if (MethodString == TEXT("GetActorRotation"))
-        {
-            const FRotator& Rotation = Actor->GetActorRotation();
-            PushRotator(L, Rotation);
-            return 1;
-        }
-        else if (MethodString == TEXT("SetActorRotation"))
-        {
-            // Expect a table with Pitch, Yaw, Roll
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "SetActorRotation requires a rotator parameter");
-            }
+int FLuaBinding::Lua_DelegateRemove(lua_State* L)
+{
+    luaL_checkudata(L, 1, MulticastDelegateMetatableName);
+    lua_pushboolean(L, ULuaDelegateThunk::Unbind(L, (uint32)luaL_checkinteger(L, 2)));
+    return 1;
+}
 
-            FRotator NewRotation = GetRotator(L, 3);
-            bool bSuccess = Actor->SetActorRotation(NewRotation);
-            lua_pushboolean(L, bSuccess);
-            return 1;
-        }
+int FLuaBinding::Lua_DelegateClear(lua_State* L)
+{
+    const FLuaMulticastDelegateProxy* Proxy = static_cast<const FLuaMulticastDelegateProxy*>(luaL_checkudata(L, 1, MulticastDelegateMetatableName));
 
-        // Scale methods
-        else if (MethodString == TEXT("GetActorScale3D"))
-        {
-            const FVector& Scale = Actor->GetActorScale3D();
-            PushVector(L, Scale);
-            return 1;
-        }
-        else if (MethodString == TEXT("SetActorScale3D"))
-        {
-            // Expect a table with X, Y, Z
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "SetActorScale3D requires a vector parameter");
-            }
+    // Only the functions this state bound are removed, native and Blueprint bindings stay
+    UObject* Object = Proxy->Object.Resolve();
+    lua_pushinteger(L, Object ? ULuaDelegateThunk::UnbindAll(L, Object, Proxy->Property) : 0);
+    return 1;
+}
 
-            FVector NewScale = GetVector(L, 3);
-            Actor->SetActorScale3D(NewScale);
-            return 0;
-        }
+// core lua funcs
 
-        // Visibility methods
-        else if (MethodString == TEXT("SetActorHiddenInGame"))
-        {
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "SetActorHiddenInGame requires a boolean parameter");
-            }
+int FLuaBinding::Lua_GetWorld(lua_State* L)
+{
+    // Get the current world
+    UWorld* World = GetWorld(L);
 
-            bool bNewHidden = (lua_toboolean(L, 3) != 0);
-            Actor->SetActorHiddenInGame(bNewHidden);
-            return 0;
-        }
-        else if (MethodString == TEXT("IsHidden"))
-        {
-            bool bHidden = Actor->IsHidden();
-            lua_pushboolean(L, bHidden);
-            return 1;
-        }
+    if (World)
+    {
+        // Push the world to Lua
+        PushUObject(L, World);
+    }
+    else
+    {
+        // No world available
+        lua_pushnil(L);
+    }
 
-        // Tags
-        else if (MethodString == TEXT("HasTag"))
-        {
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "HasTag requires a string parameter");
-            }
+    return 1;
+}
 
-            const char* TagName = lua_tostring(L, 3);
-            bool bHasTag = Actor->ActorHasTag(FName(UTF8_TO_TCHAR(TagName)));
-            lua_pushboolean(L, bHasTag);
-            return 1;
-        }
-        else if (MethodString == TEXT("AddTag"))
-        {
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "AddTag requires a string parameter");
-            }
+int FLuaBinding::Lua_Print(lua_State* L)
+{
+    // Decide where the message goes before formatting anything
+    UWorld* World = GetWorld(L);
+    const bool bOnScreen = World && (World->WorldType == EWorldType::PIE || World->WorldType == EWorldType::Game);
+    if (!FLuaLogSink::IsActive(ELogVerbosity::Display, bOnScreen))
+    {
+        return 0;
+    }
 
-            const char* TagName = lua_tostring(L, 3);
-            Actor->Tags.AddUnique(FName(UTF8_TO_TCHAR(TagName)));
-            return 0;
-        }
-        else if (MethodString == TEXT("RemoveTag"))
-        {
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "RemoveTag requires a string parameter");
-            }
+    int NumArgs = lua_gettop(L);
 
-            const char* TagName = lua_tostring(L, 3);
-            Actor->Tags.Remove(FName(UTF8_TO_TCHAR(TagName)));
-            return 0;
-        }
-        else if (MethodString == TEXT("GetNumTags"))
+    // Concatenate all arguments as UTF-8 in a Lua buffer, transcoding happens when the sink is flushed
+    luaL_Buffer Buffer;
+    luaL_buffinit(L, &Buffer);
+    for (int i = 1; i <= NumArgs; i++)
+    {
+        if (i > 1)
         {
-            lua_pushinteger(L, Actor->Tags.Num());
-            return 1;
+            luaL_addchar(&Buffer, ' ');
         }
 
-        // Other actor methods
-        else if (MethodString == TEXT("GetLifeSpan"))
+        if (lua_isstring(L, i))
         {
-            lua_pushnumber(L, Actor->GetLifeSpan());
-            return 1;
+            size_t Length = 0;
+            const char* Value = lua_tolstring(L, i, &Length);
+            luaL_addlstring(&Buffer, Value, Length);
         }
-        else if (MethodString == TEXT("SetLifeSpan"))
+        else if (lua_isboolean(L, i))
         {
-            if (lua_gettop(L) < 3)
-            {
-                return luaL_error(L, "SetLifeSpan requires a number parameter");
-            }
-
-            float Lifespan = (float)lua_tonumber(L, 3);
-            Actor->SetLifeSpan(Lifespan);
-            return 0;
+            luaL_addstring(&Buffer, lua_toboolean(L, i) ? "true" : "false");
         }
-        else if (MethodString == TEXT("CanEverTick"))
+        else if (lua_isnil(L, i))
         {
-            lua_pushboolean(L, Actor->PrimaryActorTick.bCanEverTick);
-            return 1;
+            luaL_addstring(&Buffer, "nil");
         }
-    }
-
-    // UObject methods that apply to any UObject
-    if (MethodString == TEXT("GetName"))
-    {
-        lua_pushstring(L, TCHAR_TO_UTF8(*Object->GetName()));
-        return 1;
-    }
-    else if (MethodString == TEXT("GetClass"))
-    {
-        if (Object->GetClass())
+        else
         {
-            lua_pushstring(L, TCHAR_TO_UTF8(*Object->GetClass()->GetName()));
+            lua_pushfstring(L, "[%s: %p]", luaL_typename(L, i), lua_topointer(L, i));
+            luaL_addvalue(&Buffer);
         }
-        else
-        {
-            lua_pushnil(L);
-        }
-        return 1;
     }
-    else if (MethodString == TEXT("IsA"))
-    {
-        if (lua_gettop(L) < 3)
-        {
-            return luaL_error(L, "IsA requires a string parameter");
-        }
+    luaL_pushresult(&Buffer);
 
-        const char* ClassName = lua_tostring(L, 3);
-        UClass* ClassToCheck = FindObject<UClass>(nullptr, UTF8_TO_TCHAR(ClassName));
+    size_t MessageLength = 0;
+    const char* Message = lua_tolstring(L, -1, &MessageLength);
+    FLuaLogSink::Get().Enqueue(ELogVerbosity::Display, bOnScreen, Message, (int32)MessageLength);
 
-        if (ClassToCheck)
-        {
-            lua_pushboolean(L, Object->IsA(ClassToCheck));
-        }
-        else
-        {
-            // Class not found
-            lua_pushboolean(L, false);
-        }
-        return 1;
+    return 0;
+}
+
+int FLuaBinding::Lua_GetDeltaTime(lua_State* L)
+{
+    UWorld* World = GetWorld(L);
+    if (World)
+    {
+        lua_pushnumber(L, World->GetDeltaSeconds());
+    }
+    else
+    {
+        lua_pushnumber(L, 0.0f);
     }
 
-    // If we get here, the method is not found
-    // Return nil instead of raising an error to be more forgiving in scripts
-    lua_pushnil(L);
     return 1;
 }
 
-// Helper functions for vector handling
-
-void FLuaBinding::PushVector(lua_State* L, const FVector& Vector)
+int FLuaBinding::Lua_Trace(lua_State* L)
 {
-    // Create a table with X, Y, Z fields
-    lua_newtable(L);
-
-    lua_pushnumber(L, Vector.X);
-    lua_setfield(L, -2, "X");
-
-    lua_pushnumber(L, Vector.Y);
-    lua_setfield(L, -2, "Y");
-
-    lua_pushnumber(L, Vector.Z);
-    lua_setfield(L, -2, "Z");
+    return LogMessage(L, ELogVerbosity::Log);
 }
 
-FVector FLuaBinding::GetVector(lua_State* L, int Index)
+int FLuaBinding::Lua_Warning(lua_State* L)
 {
-    FVector Result = FVector::ZeroVector;
-
-    if (lua_istable(L, Index))
-    {
-        // Get X component
-        lua_getfield(L, Index, "X");
-        if (lua_isnumber(L, -1))
-        {
-            Result.X = (float)lua_tonumber(L, -1);
-        }
-        lua_pop(L, 1);
-
-        // Get Y component
-        lua_getfield(L, Index, "Y");
-        if (lua_isnumber(L, -1))
-        {
-            Result.Y = (float)lua_tonumber(L, -1);
-        }
-        lua_pop(L, 1);
-
-        // Get Z component
-        lua_getfield(L, Index, "Z");
-        if (lua_isnumber(L, -1))
-        {
-            Result.Z = (float)lua_tonumber(L, -1);
-        }
-        lua_pop(L, 1);
-    }
-
-    return Result;
+    return LogMessage(L, ELogVerbosity::Warning);
 }
 
-// Helper functions for rotator handling
-
-void FLuaBinding::PushRotator(lua_State* L, const FRotator& Rotator)
+int FLuaBinding::Lua_Error(lua_State* L)
 {
-    // Create a table with Pitch, Yaw, Roll fields
-    lua_newtable(L);
-
-    lua_pushnumber(L, Rotator.Pitch);
-    lua_setfield(L, -2, "Pitch");
-
-    lua_pushnumber(L, Rotator.Yaw);
-    lua_setfield(L, -2, "Yaw");
-
-    lua_pushnumber(L, Rotator.Roll);
-    lua_setfield(L, -2, "Roll");
+    return LogMessage(L, ELogVerbosity::Error);
 }
 
-FRotator FLuaBinding::GetRotator(lua_State* L, int Index)
+int FLuaBinding::LogMessage(lua_State* L, ELogVerbosity::Type Verbosity)
 {
-    FRotator Result = FRotator::ZeroRotator;
+    size_t MessageLength = 0;
+    const char* Message = luaL_checklstring(L, 1, &MessageLength);
 
-    if (lua_istable(L, Index))
+    if (FLuaLogSink::IsActive(Verbosity, false))
     {
-        // Get Pitch component
-        lua_getfield(L, Index, "Pitch");
-        if (lua_isnumber(L, -1))
-        {
-            Result.Pitch = (float)lua_tonumber(L, -1);
-        }
-        lua_pop(L, 1);
-
-        // Get Yaw component
-        lua_getfield(L, Index, "Yaw");
-        if (lua_isnumber(L, -1))
-        {
-            Result.Yaw = (float)lua_tonumber(L, -1);
-        }
-        lua_pop(L, 1);
-
-        // Get Roll component
-        lua_getfield(L, Index, "Roll");
-        if (lua_isnumber(L, -1))
-        {
-            Result.Roll = (float)lua_tonumber(L, -1);
-        }
-        lua_pop(L, 1);
+        FLuaLogSink::Get().Enqueue(Verbosity, false, Message, (int32)MessageLength);
     }
-
-    return Result;
+    return 0;
 }
 
-// core lua funcs
-
-int FLuaBinding::Lua_GetWorld(lua_State* L)
+int FLuaBinding::Lua_FindActor(lua_State* L)
 {
-    // Get the current world
+    SCOPE_CYCLE_COUNTER(STAT_LuaFindActor);
+
+    luaL_checkstring(L, 1);
     UWorld* World = GetWorld(L);
+    ULuaActorRegistrySubsystem* Registry = World ? World->GetSubsystem<ULuaActorRegistrySubsystem>() : nullptr;
 
-    if (World)
+    // Names that were never turned into an FName cannot belong to any actor
+    const FName NameToFind = FLuaStringBridge::FindName(L, 1);
+
+    // Names and labels match case-sensitively, as the script wrote them
+    AActor* Actor = Registry && !NameToFind.IsNone() ? Registry->FindActorByName(NameToFind, FLuaStringBridge::ToTCHAR(L, 1)) : nullptr;
+    if (Actor)
     {
-        // Push the world to Lua
-        PushUObject(L, World);
+        PushUObject(L, Actor);
     }
     else
     {
-        // No world available
+        // Actor not found
         lua_pushnil(L);
     }
-
     return 1;
 }
 
-int FLuaBinding::Lua_Print(lua_State* L)
+int FLuaBinding::Lua_FindActorsOfClass(lua_State* L)
 {
-    int NumArgs = lua_gettop(L);
-    FString Message;
+    SCOPE_CYCLE_COUNTER(STAT_LuaFindActorsOfClass);
 
-    // Concatenate all arguments
-    for (int i = 1; i <= NumArgs; i++)
-    {
-        if (i > 1)
-        {
-            Message += " ";
-        }
+    const TCHAR* ClassName = FLuaStringBridge::ToTCHAR(L, 1);
+    const bool bIncludeDerived = lua_isnoneornil(L, 2) || lua_toboolean(L, 2);
 
-        if (lua_isstring(L, i))
-        {
-            Message += UTF8_TO_TCHAR(lua_tostring(L, i));
-        }
-        else if (lua_isnumber(L, i))
-        {
-            Message += FString::Printf(TEXT("%f"), lua_tonumber(L, i));
-        }
-        else if (lua_isboolean(L, i))
-        {
-            Message += lua_toboolean(L, i) ? TEXT("true") : TEXT("false");
-        }
-        else if (lua_isnil(L, i))
-        {
-            Message += TEXT("nil");
-        }
-        else
-        {
-            Message += FString::Printf(TEXT("[%s: %p]"), UTF8_TO_TCHAR(lua_typename(L, lua_type(L, i))), lua_topointer(L, i));
-        }
-    }
-
-    // Print to log
-    UE_LOG(LogLuaScripting, Display, TEXT("[Lua] %s"), *Message);
-
-    // Also print to screen if in PIE or game
     UWorld* World = GetWorld(L);
-    if (World && (World->WorldType == EWorldType::PIE || World->WorldType == EWorldType::Game))
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, Message);
-    }
+    ULuaActorRegistrySubsystem* Registry = World ? World->GetSubsystem<ULuaActorRegistrySubsystem>() : nullptr;
+    UClass* Class = FLuaClassCache::Get().FindClass(ClassName);
 
-    return 0;
-}
+    // Reused between calls so repeated queries don't allocate
+    static thread_local TArray<AActor*> Actors;
+    Actors.Reset();
 
-int FLuaBinding::Lua_GetDeltaTime(lua_State* L)
-{
-    UWorld* World = GetWorld(L);
-    if (World)
+    if (Registry && Class && Class->IsChildOf(AActor::StaticClass()))
     {
-        lua_pushnumber(L, World->GetDeltaSeconds());
+        Registry->FindActorsOfClass(Class, bIncludeDerived, Actors);
     }
-    else
+
+    lua_createtable(L, Actors.Num(), 0);
+    for (int32 Index = 0; Index < Actors.Num(); ++Index)
     {
-        lua_pushnumber(L, 0.0f);
+        PushUObject(L, Actors[Index]);
+        lua_rawseti(L, -2, Index + 1);
     }
-
     return 1;
 }
 
-int FLuaBinding::Lua_Trace(lua_State* L)
-{
-    const char* Message = luaL_checkstring(L, 1);
-    UE_LOG(LogLuaScripting, Log, TEXT("[Lua] %s"), UTF8_TO_TCHAR(Message));
-    return 0;
-}
-
-int FLuaBinding::Lua_Warning(lua_State* L)
+int FLuaBinding::Lua_FindByTag(lua_State* L)
 {
-    const char* Message = luaL_checkstring(L, 1);
-    UE_LOG(LogLuaScripting, Warning, TEXT("[Lua] %s"), UTF8_TO_TCHAR(Message));
-    return 0;
-}
+    SCOPE_CYCLE_COUNTER(STAT_LuaFindByTag);
 
-int FLuaBinding::Lua_Error(lua_State* L)
-{
-    const char* Message = luaL_checkstring(L, 1);
-    UE_LOG(LogLuaScripting, Error, TEXT("[Lua] %s"), UTF8_TO_TCHAR(Message));
-    return 0;
-}
+    const FName Tag = FLuaStringBridge::ToName(L, 1);
 
-int FLuaBinding::Lua_FindActor(lua_State* L)
-{
-    const char* ActorName = luaL_checkstring(L, 1);
     UWorld* World = GetWorld(L);
+    ULuaActorRegistrySubsystem* Registry = World ? World->GetSubsystem<ULuaActorRegistrySubsystem>() : nullptr;
 
-    if (!World)
-    {
-        lua_pushnil(L);
-        return 1;
-    }
+    // Reused between calls so repeated queries don't allocate
+    static thread_local TArray<AActor*> Actors;
+    Actors.Reset();
 
-    // Find actor by name
-    FString NameToFind = UTF8_TO_TCHAR(ActorName);
-    for (TActorIterator<AActor> It(World); It; ++It)
+    if (Registry)
     {
-        AActor* Actor = *It;
-
-        if (Actor->GetName().Equals(NameToFind) || Actor->GetActorLabel().Equals(NameToFind))
-        {
-            PushUObject(L, Actor);
-            return 1;
-        }
+        Registry->FindActorsWithTag(Tag, Actors);
     }
 
-    // Actor not found
-    lua_pushnil(L);
+    PushActorArray(L, Actors, 2);
     return 1;
 }
 
 int FLuaBinding::Lua_SpawnActor(lua_State* L)
 {
     // Check for class name and optional location/rotation
-    const char* ClassName = luaL_checkstring(L, 1);
+    UClass* ClassToSpawn = FindActorClass(L, 1);
 
     UWorld* World = GetWorld(L);
     if (!World)
@@ -728,19 +803,6 @@ int FLuaBinding::Lua_SpawnActor(lua_State* L)
         return 1;
     }
 
-    // Find the UClass by name
-    UClass* ClassToSpawn = nullptr;
-    for (TObjectIterator<UClass> It; It; ++It)
-    {
-        UClass* Class = *It;
-
-        if (Class->IsChildOf(AActor::StaticClass()) && Class->GetName().Equals(UTF8_TO_TCHAR(ClassName)))
-        {
-            ClassToSpawn = Class;
-            break;
-        }
-    }
-
     if (!ClassToSpawn)
     {
         lua_pushnil(L);
@@ -801,119 +863,502 @@ int FLuaBinding::Lua_DestroyActor(lua_State* L)
     return 1;
 }
 
-void FLuaBinding::RegisterEventSystem(lua_State* L)
+// Continuation of a SpawnMany call that yielded until its batch is done
+static int Lua_SpawnManyContinue(lua_State* L, int Status, lua_KContext Context)
 {
-    // Create the event system table
-    lua_getglobal(L, "UE");
-    lua_newtable(L);
+    // Resumed by the script before the batch finished, keep waiting
+    if (FLuaSpawnScheduler::Get().IsPending((uint32)Context))
+    {
+        return lua_yieldk(L, 0, Context, Lua_SpawnManyContinue);
+    }
 
-    // Create events table to store registered events
-    lua_newtable(L);
-    lua_setfield(L, -2, "_events");
+    // The scheduler resumes with the table of spawned actors
+    return 1;
+}
 
-    // Add trigger function
-    lua_pushcfunction(L, [](lua_State* L) {
-        const char* EventName = luaL_checkstring(L, 1);
+int FLuaBinding::Lua_SpawnMany(lua_State* L)
+{
+    UClass* Class = FindActorClass(L, 1);
+    const FLuaBuffer* Locations = FLuaBuffer::CheckBuffer(L, 2);
+    const FLuaBuffer* Rotations = lua_isnoneornil(L, 3) ? nullptr : FLuaBuffer::CheckBuffer(L, 3);
+    const FLuaBuffer* Scales = lua_isnoneornil(L, 4) ? nullptr : FLuaBuffer::CheckBuffer(L, 4);
 
-        // Get the events table
-        lua_getglobal(L, "UE");
-        lua_getfield(L, -1, "Event");
-        lua_getfield(L, -1, "_events");
+    double BudgetMs = 0.0;
+    if (lua_istable(L, 5))
+    {
+        lua_getfield(L, 5, "BudgetMs");
+        BudgetMs = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+    }
 
-        // Get the event handlers for this event
-        lua_getfield(L, -1, EventName);
+    // One actor per packed location, rotations and scales must cover all of them
+    const int32 NumActors = Locations->NumVectors();
+    luaL_argcheck(L, !Rotations || Rotations->NumVectors() >= NumActors, 3, "fewer rotations than locations");
+    luaL_argcheck(L, !Scales || Scales->NumVectors() >= NumActors, 4, "fewer scales than locations");
 
-        if (lua_istable(L, -1))
-        {
-            // Get the number of arguments (minus event name)
-            int NumArgs = lua_gettop(L) - 4;
+    UWorld* World = GetWorld(L);
+    if (!World || !Class || NumActors == 0)
+    {
+        lua_newtable(L);
+        return 1;
+    }
 
-            // For each handler, call it with the arguments
-            int TableLen = (int)lua_rawlen(L, -1);
-            for (int i = 1; i <= TableLen; i++)
-            {
-                lua_rawgeti(L, -1, i);
-
-                if (lua_isfunction(L, -1))
-                {
-                    // Push the arguments
-                    for (int arg = 2; arg <= NumArgs + 1; arg++)
-                    {
-                        lua_pushvalue(L, arg);
-                    }
-
-                    // Call the function
-                    lua_call(L, NumArgs, 0);
-                }
-                else
-                {
-                    lua_pop(L, 1);
-                }
-            }
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(NumActors);
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        FTransform& Transform = Transforms.Emplace_GetRef(Locations->GetVector(Index));
+        if (Rotations)
+        {
+            const FVector PitchYawRoll = Rotations->GetVector(Index);
+            Transform.SetRotation(FRotator(PitchYawRoll.X, PitchYawRoll.Y, PitchYawRoll.Z).Quaternion());
+        }
+        if (Scales)
+        {
+            Transform.SetScale3D(Scales->GetVector(Index));
         }
+    }
 
-        // Cleanup
-        lua_pop(L, 4);
+    // With a budget, spread the batch over several frames if the caller is a coroutine that can wait for it
+    if (BudgetMs > 0.0 && lua_isyieldable(L) && FLuaStateContext::Get(L))
+    {
+        const uint32 BatchId = FLuaSpawnScheduler::Get().Enqueue(L, World, Class, MoveTemp(Transforms), BudgetMs / 1000.0);
 
-        return 0;
-        });
-    lua_setfield(L, -2, "Trigger");
+        // Yielding unwinds this frame without running destructors, nothing is left owning memory here
+        return lua_yieldk(L, 0, (lua_KContext)BatchId, Lua_SpawnManyContinue);
+    }
+
+    TArray<AActor*> Actors;
+    FLuaSpawnScheduler::SpawnBatch(World, Class, Transforms, Actors);
+
+    lua_createtable(L, Actors.Num(), 0);
+    for (int32 Index = 0; Index < Actors.Num(); ++Index)
+    {
+        PushUObject(L, Actors[Index]);
+        lua_rawseti(L, -2, Index + 1);
+    }
+    return 1;
+}
+
+UClass* FLuaBinding::FindActorClass(lua_State* L, int Index)
+{
+    // Resolve the class by name or path, loading it if the script passed a path that isn't loaded yet
+    UClass* Class = FLuaClassCache::Get().FindClass(FLuaStringBridge::ToTCHAR(L, Index), true);
+    return (Class && Class->IsChildOf(AActor::StaticClass())) ? Class : nullptr;
+}
+
+FTransform FLuaBinding::GetSpawnTransform(lua_State* L, int Index)
+{
+    FTransform Transform;
+    if (FLuaValueTypes::GetTransform(L, Index, Transform))
+    {
+        return Transform;
+    }
 
-    // Add register function
-    lua_pushcfunction(L, [](lua_State* L) {
-        const char* EventName = luaL_checkstring(L, 1);
-        luaL_checktype(L, 2, LUA_TFUNCTION);
+    // Otherwise an optional location followed by an optional rotation
+    if (!lua_isnoneornil(L, Index))
+    {
+        Transform.SetLocation(FLuaValueTypes::CheckVector(L, Index));
+    }
+    if (!lua_isnoneornil(L, Index + 1))
+    {
+        Transform.SetRotation(FLuaValueTypes::CheckQuat(L, Index + 1));
+    }
+    return Transform;
+}
 
-        // Get the events table
-        lua_getglobal(L, "UE");
-        lua_getfield(L, -1, "Event");
-        lua_getfield(L, -1, "_events");
+ULuaActorPoolSubsystem* FLuaBinding::GetActorPool(lua_State* L)
+{
+    UWorld* World = GetWorld(L);
+    return World ? World->GetSubsystem<ULuaActorPoolSubsystem>() : nullptr;
+}
 
-        // Get or create the table for this event
-        lua_getfield(L, -1, EventName);
-        if (lua_isnil(L, -1))
+int FLuaBinding::Lua_Acquire(lua_State* L)
+{
+    UClass* Class = FindActorClass(L, 1);
+    const FTransform Transform = GetSpawnTransform(L, 2);
+    ULuaActorPoolSubsystem* Pool = GetActorPool(L);
+
+    AActor* Actor = (Pool && Class) ? Pool->Acquire(Class, Transform) : nullptr;
+    if (Actor)
+    {
+        PushUObject(L, Actor);
+    }
+    else
+    {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
+int FLuaBinding::Lua_Release(lua_State* L)
+{
+    AActor* Actor = Cast<AActor>(GetUObject(L, 1));
+    ULuaActorPoolSubsystem* Pool = GetActorPool(L);
+
+    lua_pushboolean(L, Pool && Pool->Release(Actor));
+    return 1;
+}
+
+int FLuaBinding::Lua_Prewarm(lua_State* L)
+{
+    UClass* Class = FindActorClass(L, 1);
+    const lua_Integer Count = luaL_checkinteger(L, 2);
+    ULuaActorPoolSubsystem* Pool = GetActorPool(L);
+
+    lua_pushinteger(L, (Pool && Class) ? Pool->Prewarm(Class, (int32)FMath::Clamp<lua_Integer>(Count, 0, MAX_int32)) : 0);
+    return 1;
+}
+
+int FLuaBinding::Lua_GetPoolStats(lua_State* L)
+{
+    UClass* Class = FindActorClass(L, 1);
+    ULuaActorPoolSubsystem* Pool = GetActorPool(L);
+    const FLuaActorPoolStats Stats = (Pool && Class) ? Pool->GetStats(Class) : FLuaActorPoolStats();
+
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, Stats.NumFree);
+    lua_setfield(L, -2, "Free");
+    lua_pushinteger(L, Stats.NumSpawned);
+    lua_setfield(L, -2, "Spawned");
+    lua_pushinteger(L, Stats.NumAcquired);
+    lua_setfield(L, -2, "Acquired");
+    lua_pushinteger(L, Stats.NumReused);
+    lua_setfield(L, -2, "Reused");
+    lua_pushinteger(L, Stats.NumReleased);
+    lua_setfield(L, -2, "Released");
+    return 1;
+}
+
+ULuaSpatialIndexSubsystem* FLuaBinding::GetSpatialIndex(lua_State* L)
+{
+    UWorld* World = GetWorld(L);
+    return World ? World->GetSubsystem<ULuaSpatialIndexSubsystem>() : nullptr;
+}
+
+void FLuaBinding::PushActorArray(lua_State* L, TConstArrayView<AActor*> Actors, int OutIndex)
+{
+    // Reuse the caller's table if given, clearing entries left over from its previous contents
+    int32 OldNum = 0;
+    if (OutIndex != 0 && lua_istable(L, OutIndex))
+    {
+        lua_pushvalue(L, OutIndex);
+        OldNum = (int32)lua_rawlen(L, -1);
+    }
+    else
+    {
+        lua_createtable(L, Actors.Num(), 0);
+    }
+
+    for (int32 Index = 0; Index < Actors.Num(); ++Index)
+    {
+        PushUObject(L, Actors[Index]);
+        lua_rawseti(L, -2, Index + 1);
+    }
+
+    for (int32 Index = OldNum; Index > Actors.Num(); --Index)
+    {
+        lua_pushnil(L);
+        lua_rawseti(L, -2, Index);
+    }
+}
+
+int FLuaBinding::Lua_TrackClass(lua_State* L)
+{
+    UClass* Class = FindActorClass(L, 1);
+    ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L);
+
+    lua_pushinteger(L, (SpatialIndex && Class) ? SpatialIndex->TrackClass(Class) : 0);
+    return 1;
+}
+
+int FLuaBinding::Lua_TrackTag(lua_State* L)
+{
+    const FName Tag = FLuaStringBridge::ToName(L, 1);
+    ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L);
+
+    lua_pushinteger(L, SpatialIndex ? SpatialIndex->TrackTag(Tag) : 0);
+    return 1;
+}
+
+int FLuaBinding::Lua_Track(lua_State* L)
+{
+    AActor* Actor = Cast<AActor>(GetUObject(L, 1));
+    ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L);
+
+    lua_pushboolean(L, SpatialIndex && SpatialIndex->TrackActor(Actor));
+    return 1;
+}
+
+int FLuaBinding::Lua_Untrack(lua_State* L)
+{
+    AActor* Actor = Cast<AActor>(GetUObject(L, 1));
+    if (ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L))
+    {
+        SpatialIndex->UntrackActor(Actor);
+    }
+    return 0;
+}
+
+int FLuaBinding::Lua_QueryRadius(lua_State* L)
+{
+    const FVector Center = FLuaValueTypes::CheckVector(L, 1);
+    const double Radius = luaL_checknumber(L, 2);
+
+    // Reused between calls so repeated queries don't allocate
+    static thread_local TArray<AActor*> Actors;
+    Actors.Reset();
+
+    if (ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L))
+    {
+        SpatialIndex->QueryRadius(Center, Radius, Actors);
+    }
+
+    PushActorArray(L, Actors, 3);
+    return 1;
+}
+
+int FLuaBinding::Lua_QueryBox(lua_State* L)
+{
+    const FVector Min = FLuaValueTypes::CheckVector(L, 1);
+    const FVector Max = FLuaValueTypes::CheckVector(L, 2);
+
+    static thread_local TArray<AActor*> Actors;
+    Actors.Reset();
+
+    if (ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L))
+    {
+        SpatialIndex->QueryBox(FBox(Min.ComponentMin(Max), Min.ComponentMax(Max)), Actors);
+    }
+
+    PushActorArray(L, Actors, 3);
+    return 1;
+}
+
+int FLuaBinding::Lua_QueryNearest(lua_State* L)
+{
+    const FVector Center = FLuaValueTypes::CheckVector(L, 1);
+    const lua_Integer Count = luaL_checkinteger(L, 2);
+    const double MaxRadius = luaL_optnumber(L, 3, UE_DOUBLE_BIG_NUMBER);
+
+    static thread_local TArray<AActor*> Actors;
+    Actors.Reset();
+
+    if (ULuaSpatialIndexSubsystem* SpatialIndex = GetSpatialIndex(L))
+    {
+        SpatialIndex->QueryNearest(Center, (int32)FMath::Clamp<lua_Integer>(Count, 0, MAX_int32), MaxRadius, Actors);
+    }
+
+    PushActorArray(L, Actors, 4);
+    return 1;
+}
+
+int FLuaBinding::Lua_SetLocations(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TTABLE);
+    const FLuaBuffer* Locations = FLuaBuffer::CheckBuffer(L, 2);
+
+    lua_pushinteger(L, ApplyActorTransforms(L, Locations, nullptr, nullptr));
+    return 1;
+}
+
+int FLuaBinding::Lua_SetRotations(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TTABLE);
+    const FLuaBuffer* Rotations = FLuaBuffer::CheckBuffer(L, 2);
+
+    lua_pushinteger(L, ApplyActorTransforms(L, nullptr, Rotations, nullptr));
+    return 1;
+}
+
+int FLuaBinding::Lua_SetScales(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TTABLE);
+    const FLuaBuffer* Scales = FLuaBuffer::CheckBuffer(L, 2);
+
+    lua_pushinteger(L, ApplyActorTransforms(L, nullptr, nullptr, Scales));
+    return 1;
+}
+
+int FLuaBinding::Lua_SetTransforms(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TTABLE);
+
+    // Any of the three buffers may be nil to leave that part of the transform untouched
+    const FLuaBuffer* Locations = lua_isnoneornil(L, 2) ? nullptr : FLuaBuffer::CheckBuffer(L, 2);
+    const FLuaBuffer* Rotations = lua_isnoneornil(L, 3) ? nullptr : FLuaBuffer::CheckBuffer(L, 3);
+    const FLuaBuffer* Scales = lua_isnoneornil(L, 4) ? nullptr : FLuaBuffer::CheckBuffer(L, 4);
+
+    lua_pushinteger(L, ApplyActorTransforms(L, Locations, Rotations, Scales));
+    return 1;
+}
+
+int32 FLuaBinding::ApplyActorTransforms(lua_State* L, const FLuaBuffer* Locations, const FLuaBuffer* Rotations, const FLuaBuffer* Scales)
+{
+    const int32 NumActors = (int32)lua_rawlen(L, 1);
+
+    // Every buffer needs one packed triple per actor
+    for (const FLuaBuffer* Buffer : { Locations, Rotations, Scales })
+    {
+        if (Buffer && Buffer->NumVectors() < NumActors)
         {
-            lua_pop(L, 1);
-            lua_newtable(L);
-            lua_pushvalue(L, -1);
-            lua_setfield(L, -3, EventName);
+            luaL_error(L, "buffer holds %d vectors but %d actors were given", Buffer->NumVectors(), NumActors);
         }
+    }
+
+    int32 NumUpdated = 0;
+    for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+    {
+        lua_rawgeti(L, 1, ActorIndex + 1);
+        AActor* Actor = Cast<AActor>(GetUObject(L, -1));
+        lua_pop(L, 1);
 
-        // Add the function to the event table
-        int TableLen = (int)lua_rawlen(L, -1) + 1;
-        lua_pushvalue(L, 2);
-        lua_rawseti(L, -2, TableLen);
+        if (!Actor || !Actor->GetRootComponent())
+        {
+            continue;
+        }
 
-        // Cleanup
-        lua_pop(L, 4);
+        // Build the final transform first so the root component is moved, and its children updated, only once
+        FTransform Transform = Actor->GetActorTransform();
+        if (Locations)
+        {
+            Transform.SetLocation(Locations->GetVector(ActorIndex));
+        }
+        if (Rotations)
+        {
+            const FVector PitchYawRoll = Rotations->GetVector(ActorIndex);
+            Transform.SetRotation(FRotator(PitchYawRoll.X, PitchYawRoll.Y, PitchYawRoll.Z).Quaternion());
+        }
+        if (Scales)
+        {
+            Transform.SetScale3D(Scales->GetVector(ActorIndex));
+        }
 
-        return 0;
-        });
-    lua_setfield(L, -2, "Register");
+        Actor->SetActorTransform(Transform);
+        ++NumUpdated;
+    }
 
-    // Add unregister function
-    lua_pushcfunction(L, [](lua_State* L) {
-        const char* EventName = luaL_checkstring(L, 1);
+    return NumUpdated;
+}
 
-        // Get the events table
-        lua_getglobal(L, "UE");
-        lua_getfield(L, -1, "Event");
-        lua_getfield(L, -1, "_events");
+void FLuaBinding::RegisterEventSystem(lua_State* L)
+{
+    // Create the event system table, handlers live in the state's native event bus. Events leaving the state are
+    // recorded when sent from a parallel tick; registering updates the process-wide subscriber map, which only the
+    // game thread may do
+    lua_getglobal(L, "UE");
+    lua_newtable(L);
 
-        // Clear the event table for this event
-        lua_pushnil(L);
-        lua_setfield(L, -2, EventName);
+    lua_pushcfunction(L, Lua_TriggerEvent);
+    lua_setfield(L, -2, "Trigger");
 
-        // Cleanup
-        lua_pop(L, 3);
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_RegisterEvent>);
+    lua_setfield(L, -2, "Register");
 
-        return 0;
-        });
+    lua_pushcfunction(L, FLuaCommandBuffer::GameThreadOnly<Lua_UnregisterEvent>);
     lua_setfield(L, -2, "Unregister");
 
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_BroadcastEvent>);
+    lua_setfield(L, -2, "Broadcast");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_PostEvent>);
+    lua_setfield(L, -2, "Post");
+
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_PostCoalescedEvent>);
+    lua_setfield(L, -2, "PostCoalesced");
+
     // Set the Event table in the UE namespace
     lua_setfield(L, -2, "Event");
 
     // Pop the UE table
     lua_pop(L, 1);
+}
+
+FLuaEventBus& FLuaBinding::GetEventBus(lua_State* L)
+{
+    FLuaStateContext* Context = FLuaStateContext::Get(L);
+    if (!Context)
+    {
+        luaL_error(L, "UE.Event is not available in this Lua state");
+    }
+    return Context->Events;
+}
+
+int FLuaBinding::Lua_RegisterEvent(lua_State* L)
+{
+    const FName Event = FLuaStringBridge::ToName(L, 1);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    lua_pushinteger(L, GetEventBus(L).Register(L, Event, 2));
+    return 1;
+}
+
+int FLuaBinding::Lua_TriggerEvent(lua_State* L)
+{
+    const FName Event = FLuaStringBridge::ToName(L, 1);
+
+    // Everything after the event name is passed to the handlers
+    GetEventBus(L).Trigger(L, Event, 2, lua_gettop(L) - 1);
+    return 0;
+}
+
+int FLuaBinding::Lua_BroadcastEvent(lua_State* L)
+{
+    const FName Event = FLuaStringBridge::ToName(L, 1);
+
+    const char* Error = nullptr;
+    if (!FLuaStateManager::Get().BroadcastEvent(L, Event, 2, lua_gettop(L) - 1, Error))
+    {
+        return luaL_error(L, "UE.Event.Broadcast: %s", Error);
+    }
+    return 0;
+}
+
+int FLuaBinding::Lua_PostEvent(lua_State* L)
+{
+    return PostEvent(L, NAME_None);
+}
+
+int FLuaBinding::Lua_PostCoalescedEvent(lua_State* L)
+{
+    // The key is also the first argument of the handlers
+    return PostEvent(L, FLuaStringBridge::ToName(L, 2));
+}
+
+int FLuaBinding::PostEvent(lua_State* L, FName CoalesceKey)
+{
+    const FName Event = FLuaStringBridge::ToName(L, 1);
+    FLuaEventBus& EventBus = GetEventBus(L);
+
+    UWorld* World = GetWorld(L);
+    ULuaEventQueueSubsystem* EventQueue = World ? World->GetSubsystem<ULuaEventQueueSubsystem>() : nullptr;
+    if (!EventQueue)
+    {
+        return luaL_error(L, "UE.Event.Post can only be used by scripts running in a game world");
+    }
+
+    const char* Error = nullptr;
+    if (!EventBus.Post(L, Event, 2, lua_gettop(L) - 1, CoalesceKey, Error))
+    {
+        return luaL_error(L, "UE.Event.Post: %s", Error);
+    }
+
+    EventQueue->MarkPending(L);
+    return 0;
+}
+
+int FLuaBinding::Lua_UnregisterEvent(lua_State* L)
+{
+    FLuaEventBus& EventBus = GetEventBus(L);
+
+    // A handle removes one handler, an event name removes all of them
+    if (lua_type(L, 1) == LUA_TNUMBER)
+    {
+        lua_pushboolean(L, EventBus.Unregister(L, (uint32)luaL_checkinteger(L, 1)));
+    }
+    else
+    {
+        lua_pushboolean(L, EventBus.UnregisterAll(L, FLuaStringBridge::ToName(L, 1)) > 0);
+    }
+    return 1;
 }
\ No newline at end of file
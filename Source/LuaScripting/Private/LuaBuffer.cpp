@@ -0,0 +1,323 @@
+#include "LuaBuffer.h"
+#include "LuaStateManager.h"
+#include "LuaValueTypes.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+// Registry name of the buffer metatable
+static const char* BufferMetatableName = "LuaBuffer";
+
+// Names accepted by UE.Buffer.New, in ELuaBufferType order
+static const char* const BufferTypeNames[] = { "float32", "float64", "int32", nullptr };
+
+static_assert(sizeof(FLuaBuffer) <= 16, "FLuaBuffer header must fit in HeaderSize");
+
+int32 FLuaBuffer::GetElementSize(ELuaBufferType InType)
+{
+    switch (InType)
+    {
+    case ELuaBufferType::Float32: return sizeof(float);
+    case ELuaBufferType::Float64: return sizeof(double);
+    case ELuaBufferType::Int32: return sizeof(int32);
+    }
+    return 0;
+}
+
+double FLuaBuffer::GetElement(int32 Index) const
+{
+    switch (Type)
+    {
+    case ELuaBufferType::Float32: return static_cast<const float*>(GetData())[Index];
+    case ELuaBufferType::Float64: return static_cast<const double*>(GetData())[Index];
+    case ELuaBufferType::Int32: return static_cast<const int32*>(GetData())[Index];
+    }
+    return 0.0;
+}
+
+void FLuaBuffer::SetElement(int32 Index, double Value)
+{
+    switch (Type)
+    {
+    case ELuaBufferType::Float32: static_cast<float*>(GetData())[Index] = (float)Value; break;
+    case ELuaBufferType::Float64: static_cast<double*>(GetData())[Index] = Value; break;
+    // Truncated like a C cast, but NaN reads as 0 and values out of range are clamped instead of being undefined
+    case ELuaBufferType::Int32: static_cast<int32*>(GetData())[Index] = FMath::IsNaN(Value) ? 0 : (int32)FMath::Clamp(Value, (double)MIN_int32, (double)MAX_int32); break;
+    }
+}
+
+FLuaBuffer* FLuaBuffer::Push(lua_State* L, ELuaBufferType Type, int32 Num)
+{
+    const SIZE_T DataSize = (SIZE_T)FMath::Max(Num, 0) * GetElementSize(Type);
+
+    void* Storage = lua_newuserdatauv(L, HeaderSize + DataSize, 0);
+    FLuaBuffer* Buffer = new (Storage) FLuaBuffer(Type, FMath::Max(Num, 0));
+    FMemory::Memzero(Buffer->GetData(), DataSize);
+
+    luaL_setmetatable(L, BufferMetatableName);
+    return Buffer;
+}
+
+FLuaBuffer* FLuaBuffer::PushCopy(lua_State* L, const FLuaBuffer& Source)
+{
+    FLuaBuffer* Buffer = Push(L, Source.Type, Source.NumElements);
+    FMemory::Memcpy(Buffer->GetData(), Source.GetData(), (SIZE_T)Source.NumElements * GetElementSize(Source.Type));
+    return Buffer;
+}
+
+FLuaBuffer* FLuaBuffer::ToBuffer(lua_State* L, int Index)
+{
+    return static_cast<FLuaBuffer*>(luaL_testudata(L, Index, BufferMetatableName));
+}
+
+FLuaBuffer* FLuaBuffer::CheckBuffer(lua_State* L, int Index)
+{
+    return static_cast<FLuaBuffer*>(luaL_checkudata(L, Index, BufferMetatableName));
+}
+
+namespace LuaBuffer
+{
+    // Convert a 1-based Lua index to a 0-based element index, or INDEX_NONE if out of range
+    int32 ToElementIndex(const FLuaBuffer* Buffer, lua_Integer LuaIndex)
+    {
+        return (LuaIndex >= 1 && LuaIndex <= Buffer->Num()) ? (int32)(LuaIndex - 1) : INDEX_NONE;
+    }
+
+    void PushElement(lua_State* L, const FLuaBuffer* Buffer, int32 Element)
+    {
+        if (Buffer->GetType() == ELuaBufferType::Int32)
+        {
+            lua_pushinteger(L, (lua_Integer)Buffer->GetElement(Element));
+        }
+        else
+        {
+            lua_pushnumber(L, Buffer->GetElement(Element));
+        }
+    }
+
+    // Fill a buffer from a Lua array of numbers
+    void CopyFromTable(lua_State* L, FLuaBuffer* Buffer, int TableIndex, int32 FirstElement)
+    {
+        const int32 Num = FMath::Min((int32)lua_rawlen(L, TableIndex), Buffer->Num() - FirstElement);
+        for (int32 Element = 0; Element < Num; ++Element)
+        {
+            lua_rawgeti(L, TableIndex, Element + 1);
+            Buffer->SetElement(FirstElement + Element, lua_tonumber(L, -1));
+            lua_pop(L, 1);
+        }
+    }
+
+    // UE.Buffer.New(type, numOrTable)
+    int Lua_New(lua_State* L)
+    {
+        const ELuaBufferType Type = (ELuaBufferType)luaL_checkoption(L, 1, "float32", BufferTypeNames);
+
+        if (lua_istable(L, 2))
+        {
+            FLuaBuffer* Buffer = FLuaBuffer::Push(L, Type, (int32)lua_rawlen(L, 2));
+            CopyFromTable(L, Buffer, 2, 0);
+        }
+        else
+        {
+            const lua_Integer Num = luaL_checkinteger(L, 2);
+            luaL_argcheck(L, Num >= 0 && Num <= MAX_int32, 2, "invalid buffer size");
+            FLuaBuffer::Push(L, Type, (int32)Num);
+        }
+        return 1;
+    }
+
+    // UE.Buffer.Float32(numOrTable) and friends
+    template<ELuaBufferType Type>
+    int Lua_NewTyped(lua_State* L)
+    {
+        lua_pushstring(L, BufferTypeNames[(int32)Type]);
+        lua_insert(L, 1);
+        return Lua_New(L);
+    }
+
+    // __index: integer keys read elements, string keys look up methods in the upvalue table
+    int Lua_Index(lua_State* L)
+    {
+        const FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+
+        if (lua_isinteger(L, 2))
+        {
+            const int32 Element = ToElementIndex(Buffer, lua_tointeger(L, 2));
+            if (Element == INDEX_NONE)
+            {
+                lua_pushnil(L);
+            }
+            else
+            {
+                PushElement(L, Buffer, Element);
+            }
+            return 1;
+        }
+
+        lua_pushvalue(L, 2);
+        lua_rawget(L, lua_upvalueindex(1));
+        return 1;
+    }
+
+    int Lua_NewIndex(lua_State* L)
+    {
+        FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+
+        const int32 Element = lua_isinteger(L, 2) ? ToElementIndex(Buffer, lua_tointeger(L, 2)) : INDEX_NONE;
+        if (Element == INDEX_NONE)
+        {
+            return luaL_error(L, "buffer index out of range (buffer has %d elements)", Buffer->Num());
+        }
+
+        Buffer->SetElement(Element, luaL_checknumber(L, 3));
+        return 0;
+    }
+
+    int Lua_Len(lua_State* L)
+    {
+        lua_pushinteger(L, FLuaBuffer::CheckBuffer(L, 1)->Num());
+        return 1;
+    }
+
+    int Lua_ToString(lua_State* L)
+    {
+        const FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+        lua_pushfstring(L, "Buffer<%s>[%d]", BufferTypeNames[(int32)Buffer->GetType()], Buffer->Num());
+        return 1;
+    }
+
+    int Lua_Type(lua_State* L)
+    {
+        lua_pushstring(L, BufferTypeNames[(int32)FLuaBuffer::CheckBuffer(L, 1)->GetType()]);
+        return 1;
+    }
+
+    // buffer:Fill(value)
+    int Lua_Fill(lua_State* L)
+    {
+        FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+        const double Value = luaL_checknumber(L, 2);
+        for (int32 Element = 0; Element < Buffer->Num(); ++Element)
+        {
+            Buffer->SetElement(Element, Value);
+        }
+
+        lua_settop(L, 1);
+        return 1;
+    }
+
+    // buffer:FromTable(table[, firstIndex])
+    int Lua_FromTable(lua_State* L)
+    {
+        FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+        luaL_checktype(L, 2, LUA_TTABLE);
+        const lua_Integer FirstIndex = luaL_optinteger(L, 3, 1);
+        luaL_argcheck(L, FirstIndex >= 1 && FirstIndex <= (lua_Integer)Buffer->Num() + 1, 3, "index out of range");
+
+        CopyFromTable(L, Buffer, 2, (int32)FirstIndex - 1);
+
+        lua_settop(L, 1);
+        return 1;
+    }
+
+    // buffer:ToTable() creates a snapshot of the elements
+    int Lua_ToTable(lua_State* L)
+    {
+        const FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+
+        lua_createtable(L, Buffer->Num(), 0);
+        for (int32 Element = 0; Element < Buffer->Num(); ++Element)
+        {
+            PushElement(L, Buffer, Element);
+            lua_rawseti(L, -2, Element + 1);
+        }
+        return 1;
+    }
+
+    // buffer:GetVector(i, out) reads the i-th packed X, Y, Z triple, into out if given
+    int Lua_GetVector(lua_State* L)
+    {
+        const FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+        const lua_Integer VectorIndex = luaL_checkinteger(L, 2);
+        luaL_argcheck(L, VectorIndex >= 1 && VectorIndex <= Buffer->NumVectors(), 2, "vector index out of range");
+
+        FLuaValueTypes::PushVector(L, Buffer->GetVector((int32)VectorIndex - 1), 3);
+        return 1;
+    }
+
+    // buffer:SetVector(i, vector) writes the i-th packed X, Y, Z triple
+    int Lua_SetVector(lua_State* L)
+    {
+        FLuaBuffer* Buffer = FLuaBuffer::CheckBuffer(L, 1);
+        const lua_Integer VectorIndex = luaL_checkinteger(L, 2);
+        luaL_argcheck(L, VectorIndex >= 1 && VectorIndex <= Buffer->NumVectors(), 2, "vector index out of range");
+
+        Buffer->SetVector((int32)VectorIndex - 1, FLuaValueTypes::CheckVector(L, 3));
+        return 0;
+    }
+
+    const luaL_Reg Methods[] = {
+        { "Num", Lua_Len },
+        { "Type", Lua_Type },
+        { "Fill", Lua_Fill },
+        { "FromTable", Lua_FromTable },
+        { "ToTable", Lua_ToTable },
+        { "GetVector", Lua_GetVector },
+        { "SetVector", Lua_SetVector },
+        { nullptr, nullptr }
+    };
+}
+
+void FLuaBuffer::Register(lua_State* L)
+{
+    using namespace LuaBuffer;
+
+    if (luaL_newmetatable(L, BufferMetatableName))
+    {
+        // Method table used by __index for non-integer keys
+        lua_newtable(L);
+        luaL_setfuncs(L, Methods, 0);
+        lua_pushcclosure(L, Lua_Index, 1);
+        lua_setfield(L, -2, "__index");
+
+        lua_pushcfunction(L, Lua_NewIndex);
+        lua_setfield(L, -2, "__newindex");
+
+        lua_pushcfunction(L, Lua_Len);
+        lua_setfield(L, -2, "__len");
+
+        lua_pushcfunction(L, Lua_ToString);
+        lua_setfield(L, -2, "__tostring");
+    }
+
+    // Pop the metatable
+    lua_pop(L, 1);
+
+    // Get the UE namespace table
+    lua_getglobal(L, "UE");
+
+    // Create the Buffer table
+    lua_newtable(L);
+
+    lua_pushcfunction(L, Lua_New);
+    lua_setfield(L, -2, "New");
+
+    lua_pushcfunction(L, Lua_NewTyped<ELuaBufferType::Float32>);
+    lua_setfield(L, -2, "Float32");
+
+    lua_pushcfunction(L, Lua_NewTyped<ELuaBufferType::Float64>);
+    lua_setfield(L, -2, "Float64");
+
+    lua_pushcfunction(L, Lua_NewTyped<ELuaBufferType::Int32>);
+    lua_setfield(L, -2, "Int32");
+
+    // Set the Buffer table in the UE namespace
+    lua_setfield(L, -2, "Buffer");
+
+    // Pop the UE table
+    lua_pop(L, 1);
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "LuaClassCache.h"
+#include "LuaStateManager.h"
+#include "LuaStringBridge.h"
+#include "LuaCommandBuffer.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/ScopeRWLock.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Class cache hits"), STAT_LuaClassCacheHits, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Class cache misses"), STAT_LuaClassCacheMisses, STATGROUP_LuaScripting);
+
+FLuaClassCache& FLuaClassCache::Get()
+{
+    static FLuaClassCache Instance;
+    return Instance;
+}
+
+FLuaClassCache::FLuaClassCache()
+{
+}
+
+FLuaClassCache::~FLuaClassCache()
+{
+}
+
+void FLuaClassCache::Startup()
+{
+    if (!ReloadCompleteHandle.IsValid())
+    {
+        // Hot reload and live coding replace classes wholesale
+        ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+        {
+            Clear();
+        });
+    }
+}
+
+void FLuaClassCache::Shutdown()
+{
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+    ReloadCompleteHandle.Reset();
+
+    for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : PreloadHandles)
+    {
+        if (Pair.Value.IsValid())
+        {
+            Pair.Value->ReleaseHandle();
+        }
+    }
+    PreloadHandles.Empty();
+    StreamableManager.Reset();
+
+    Clear();
+}
+
+void FLuaClassCache::Clear()
+{
+    FWriteScopeLock WriteLock(ClassesLock);
+    Classes.Empty();
+}
+
+bool FLuaClassCache::IsPath(const TCHAR* Name)
+{
+    return FCString::Strchr(Name, TEXT('/')) != nullptr || FCString::Strchr(Name, TEXT('\'')) != nullptr;
+}
+
+UClass* FLuaClassCache::ResolveClass(const TCHAR* Name, bool bLoad)
+{
+    UClass* Class = nullptr;
+    if (IsPath(Name))
+    {
+        // Handles both plain object paths and Class'/Path.Name' export text
+        const FSoftClassPath ClassPath{ FString(Name) };
+        Class = ClassPath.ResolveClass();
+        if (!Class && bLoad && ClassPath.IsValid())
+        {
+            UE_LOG(LogLuaScripting, Verbose, TEXT("Loading class %s synchronously, consider UE.Class.Preload"), Name);
+            Class = ClassPath.TryLoadClass<UObject>();
+        }
+    }
+    else
+    {
+        Class = FindFirstObject<UClass>(Name, EFindFirstObjectOptions::NativeFirst);
+    }
+
+    // Skip classes left behind by blueprint recompiles
+    return (Class && !Class->HasAnyClassFlags(CLASS_NewerVersionExists)) ? Class : nullptr;
+}
+
+UClass* FLuaClassCache::FindClass(const TCHAR* Name, bool bLoad)
+{
+    // Scripts of a parallel tick look classes up from worker threads, but never load them
+    check(IsInGameThread() || FLuaCommandBuffer::IsRecording());
+    bLoad = bLoad && !FLuaCommandBuffer::IsRecording();
+
+    // A name that was never interned cannot have been cached
+    const FName Key(Name, FNAME_Find);
+    if (!Key.IsNone())
+    {
+        FReadScopeLock ReadLock(ClassesLock);
+        if (const TWeakObjectPtr<UClass>* Cached = Classes.Find(Key))
+        {
+            UClass* Class = Cached->Get();
+            if (Class && !Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+            {
+                INC_DWORD_STAT(STAT_LuaClassCacheHits);
+                return Class;
+            }
+        }
+    }
+
+    INC_DWORD_STAT(STAT_LuaClassCacheMisses);
+
+    UClass* Class = ResolveClass(Name, bLoad);
+    if (Class)
+    {
+        FWriteScopeLock WriteLock(ClassesLock);
+        Classes.Add(Key.IsNone() ? FName(Name) : Key, Class);
+    }
+    return Class;
+}
+
+bool FLuaClassCache::Preload(const TCHAR* Name)
+{
+    check(IsInGameThread());
+
+    if (FindClass(Name))
+    {
+        return true;
+    }
+
+    const FSoftClassPath ClassPath{ FString(Name) };
+    if (!ClassPath.IsValid() || PreloadHandles.Contains(ClassPath))
+    {
+        return false;
+    }
+
+    if (!StreamableManager)
+    {
+        StreamableManager = MakeUnique<FStreamableManager>();
+    }
+
+    // The handle keeps the class loaded once it arrives
+    PreloadHandles.Add(ClassPath, StreamableManager->RequestAsyncLoad(ClassPath, FStreamableDelegate()));
+    return false;
+}
+
+namespace LuaClassCache
+{
+    // UE.Class.Find(name) returns the resolved class name or nil, without loading anything
+    int Lua_Find(lua_State* L)
+    {
+        UClass* Class = FLuaClassCache::Get().FindClass(FLuaStringBridge::ToTCHAR(L, 1));
+        if (Class)
+        {
+            FLuaStringBridge::PushString(L, Class->GetPathName());
+        }
+        else
+        {
+            lua_pushnil(L);
+        }
+        return 1;
+    }
+
+    // UE.Class.IsLoaded(name)
+    int Lua_IsLoaded(lua_State* L)
+    {
+        lua_pushboolean(L, FLuaClassCache::Get().FindClass(FLuaStringBridge::ToTCHAR(L, 1)) != nullptr);
+        return 1;
+    }
+
+    // UE.Class.Preload(path) starts an async load, returns true if the class is already available
+    int Lua_Preload(lua_State* L)
+    {
+        lua_pushboolean(L, FLuaClassCache::Get().Preload(FLuaStringBridge::ToTCHAR(L, 1)));
+        return 1;
+    }
+}
+
+void FLuaClassCache::Register(lua_State* L)
+{
+    using namespace LuaClassCache;
+
+    // Get the UE namespace table
+    lua_getglobal(L, "UE");
+
+    // Create the Class table
+    lua_newtable(L);
+
+    lua_pushcfunction(L, Lua_Find);
+    lua_setfield(L, -2, "Find");
+
+    lua_pushcfunction(L, Lua_IsLoaded);
+    lua_setfield(L, -2, "IsLoaded");
+
+    // Preloading is started on the game thread after a parallel tick
+    lua_pushcfunction(L, FLuaCommandBuffer::Deferrable<Lua_Preload>);
+    lua_setfield(L, -2, "Preload");
+
+    // Set the Class table in the UE namespace
+    lua_setfield(L, -2, "Class");
+
+    // Pop the UE table
+    lua_pop(L, 1);
+}
\ No newline at end of file
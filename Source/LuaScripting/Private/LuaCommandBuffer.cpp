@@ -0,0 +1,234 @@
+#include "LuaCommandBuffer.h"
+#include "LuaStateManager.h"
+#include "LuaValueTypes.h"
+#include "LuaBuffer.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recorded calls"), STAT_LuaRecordedCalls, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("Apply recorded calls"), STAT_LuaApplyRecordedCalls, STATGROUP_LuaScripting);
+
+namespace LuaCommandBuffer
+{
+    // Buffer the calling thread records into, null outside of a parallel tick
+    thread_local FLuaCommandBuffer* Current = nullptr;
+
+    // Registry key of each state's table of pending arguments, slot 0 holds the number of slots in use; only its
+    // address matters, it is not const so it can't be merged with other constants
+    static char PendingArgsKey = 0;
+
+    void PushPendingArgs(lua_State* L)
+    {
+        if (lua_rawgetp(L, LUA_REGISTRYINDEX, &PendingArgsKey) == LUA_TTABLE)
+        {
+            return;
+        }
+
+        lua_pop(L, 1);
+        lua_createtable(L, 8, 0);
+        lua_pushinteger(L, 0);
+        lua_rawseti(L, -2, 0);
+        lua_pushvalue(L, -1);
+        lua_rawsetp(L, LUA_REGISTRYINDEX, &PendingArgsKey);
+    }
+
+    // Tables nested deeper than this are refused rather than copied
+    constexpr int32 MaxTableDepth = 16;
+
+    void PushArgument(lua_State* L, int Index, int CopiesIndex, int32 Depth);
+
+    // Push a copy of the table at Index; CopiesIndex maps the tables copied so far to their copies, so shared and
+    // cyclic tables are copied once
+    void PushTableCopy(lua_State* L, int Index, int CopiesIndex, int32 Depth)
+    {
+        if (Depth > MaxTableDepth)
+        {
+            luaL_error(L, "table argument nested too deeply to be recorded in a parallel tick");
+        }
+        luaL_checkstack(L, 6, nullptr);
+
+        lua_pushvalue(L, Index);
+        if (lua_rawget(L, CopiesIndex) == LUA_TTABLE)
+        {
+            return;
+        }
+        lua_pop(L, 1);
+
+        lua_createtable(L, (int)lua_rawlen(L, Index), 0);
+        const int CopyIndex = lua_gettop(L);
+        lua_pushvalue(L, Index);
+        lua_pushvalue(L, CopyIndex);
+        lua_rawset(L, CopiesIndex);
+
+        // Struct and class-like tables keep their metatable
+        if (lua_getmetatable(L, Index))
+        {
+            lua_setmetatable(L, CopyIndex);
+        }
+
+        lua_pushnil(L);
+        while (lua_next(L, Index) != 0)
+        {
+            // Keys are kept as they are, values are copied like arguments
+            PushArgument(L, lua_gettop(L), CopiesIndex, Depth + 1);
+            lua_pushvalue(L, -3);
+            lua_insert(L, -2);
+            lua_rawset(L, CopyIndex);
+            lua_pop(L, 1);
+        }
+    }
+
+    // Push an argument to keep, copying everything a script may change before the call is applied: value types,
+    // buffers and tables (e.g. one table reused for the positions of many calls)
+    void PushArgument(lua_State* L, int Index, int CopiesIndex, int32 Depth)
+    {
+        if (lua_type(L, Index) == LUA_TTABLE)
+        {
+            PushTableCopy(L, lua_absindex(L, Index), CopiesIndex, Depth);
+            return;
+        }
+
+        if (lua_type(L, Index) == LUA_TUSERDATA)
+        {
+            if (const FLuaBuffer* Buffer = FLuaBuffer::ToBuffer(L, Index))
+            {
+                FLuaBuffer::PushCopy(L, *Buffer);
+                return;
+            }
+            if (const FVector* Vector = FLuaValueTypes::ToVectorUserdata(L, Index))
+            {
+                FLuaValueTypes::PushVector(L, *Vector);
+                return;
+            }
+            if (const FRotator* Rotator = FLuaValueTypes::ToRotatorUserdata(L, Index))
+            {
+                FLuaValueTypes::PushRotator(L, *Rotator);
+                return;
+            }
+            if (const FQuat* Quat = FLuaValueTypes::ToQuatUserdata(L, Index))
+            {
+                FLuaValueTypes::PushQuat(L, *Quat);
+                return;
+            }
+            if (const FTransform* Transform = FLuaValueTypes::ToTransformUserdata(L, Index))
+            {
+                FLuaValueTypes::PushTransform(L, *Transform);
+                return;
+            }
+        }
+
+        lua_pushvalue(L, Index);
+    }
+}
+
+bool FLuaCommandBuffer::IsRecording()
+{
+    return LuaCommandBuffer::Current != nullptr;
+}
+
+int FLuaCommandBuffer::Record(lua_State* L, lua_CFunction Function)
+{
+    using namespace LuaCommandBuffer;
+
+    check(Current);
+
+    const int NumArgs = lua_gettop(L);
+    luaL_checkstack(L, 4, nullptr);
+
+    // Originals of the tables copied for this call and their copies
+    lua_newtable(L);
+    const int CopiesIndex = lua_gettop(L);
+
+    PushPendingArgs(L);
+    lua_rawgeti(L, -1, 0);
+    const int32 FirstArg = (int32)lua_tointeger(L, -1) + 1;
+    lua_pop(L, 1);
+
+    for (int Arg = 1; Arg <= NumArgs; ++Arg)
+    {
+        PushArgument(L, Arg, CopiesIndex, 0);
+        lua_rawseti(L, -2, FirstArg + Arg - 1);
+    }
+    lua_pushinteger(L, FirstArg + NumArgs - 1);
+    lua_rawseti(L, -2, 0);
+    lua_pop(L, 2);
+
+    // Applied on the main thread, the calling coroutine may be finished or suspended by then
+    lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+    lua_State* MainThread = lua_tothread(L, -1);
+    lua_pop(L, 1);
+
+    Current->Commands.Add({ MainThread, Function, FirstArg, NumArgs });
+    INC_DWORD_STAT(STAT_LuaRecordedCalls);
+    return 0;
+}
+
+void FLuaCommandBuffer::DiscardPendingArguments(lua_State* L)
+{
+    lua_pushnil(L);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &LuaCommandBuffer::PendingArgsKey);
+}
+
+int FLuaCommandBuffer::RaiseGameThreadOnly(lua_State* L)
+{
+    return luaL_error(L, "this function cannot be called from a parallel tick");
+}
+
+FLuaCommandBuffer::FScopedRecording::FScopedRecording(FLuaCommandBuffer& Buffer)
+    : Previous(LuaCommandBuffer::Current)
+{
+    LuaCommandBuffer::Current = &Buffer;
+}
+
+FLuaCommandBuffer::FScopedRecording::~FScopedRecording()
+{
+    LuaCommandBuffer::Current = Previous;
+}
+
+void FLuaCommandBuffer::Apply(const TSet<lua_State*>& ReleasedStates)
+{
+    using namespace LuaCommandBuffer;
+
+    check(IsInGameThread() && !IsRecording());
+    SCOPE_CYCLE_COUNTER(STAT_LuaApplyRecordedCalls);
+
+    for (int32 Index = 0; Index < Commands.Num(); ++Index)
+    {
+        // Checked for every call, an earlier call may have destroyed the actor owning the state
+        const FCommand& Command = Commands[Index];
+        lua_State* L = Command.State;
+        if (ReleasedStates.Contains(L))
+        {
+            continue;
+        }
+
+        lua_pushcfunction(L, Command.Function);
+        PushPendingArgs(L);
+        const int ArgsIndex = lua_gettop(L);
+        for (int32 Arg = 0; Arg < Command.NumArgs; ++Arg)
+        {
+            lua_rawgeti(L, ArgsIndex, Command.FirstArg + Arg);
+        }
+        lua_remove(L, ArgsIndex);
+
+        if (lua_pcall(L, Command.NumArgs, 0, 0) != LUA_OK)
+        {
+            UE_LOG(LogLuaScripting, Error, TEXT("Error in recorded Lua call: %s"), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+            lua_pop(L, 1);
+        }
+
+        // A state records all its calls in one run, its arguments are dropped after the last one
+        const bool bLastOfState = Index + 1 == Commands.Num() || Commands[Index + 1].State != L;
+        if (bLastOfState && !ReleasedStates.Contains(L))
+        {
+            DiscardPendingArguments(L);
+        }
+    }
+
+    Commands.Reset();
+}
\ No newline at end of file
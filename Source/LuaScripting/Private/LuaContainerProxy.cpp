@@ -0,0 +1,684 @@
+#include "LuaContainerProxy.h"
+#include "LuaPropertyMarshal.h"
+#include "LuaObjectHandle.h"
+#include "LuaStateManager.h"
+#include "LuaCommandBuffer.h"
+#include "UObject/UnrealType.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Container snapshots"), STAT_LuaContainerSnapshots, STATGROUP_LuaScripting);
+
+namespace LuaContainerProxy
+{
+    // Registry names of the proxy metatables
+    const char* ArrayMetatableName = "UArray";
+    const char* MapMetatableName = "UMap";
+    const char* SetMetatableName = "USet";
+
+    // Userdata behind a container proxy
+    struct FProxy
+    {
+        FLuaObjectHandle Object;
+        const FProperty* Property;
+    };
+
+    // Value of a property in scratch memory, for map keys, map values and set elements converted from Lua
+    // Only used around calls that cannot raise a Lua error, so the destructor always runs
+    struct FScopedValue
+    {
+        explicit FScopedValue(const FProperty* InProperty)
+            : Property(InProperty)
+            , Data(FMemory::Malloc(InProperty->GetSize(), InProperty->GetMinAlignment()))
+        {
+            Property->InitializeValue(Data);
+        }
+
+        ~FScopedValue()
+        {
+            Property->DestroyValue(Data);
+            FMemory::Free(Data);
+        }
+
+        const FProperty* Property;
+        void* Data;
+    };
+
+    // Resolve a proxy to its container memory, raising a Lua error if the owning object is gone
+    template<typename PropertyType>
+    void* CheckProxy(lua_State* L, int Index, const char* MetatableName, const PropertyType*& OutProperty)
+    {
+        const FProxy* Proxy = static_cast<const FProxy*>(luaL_checkudata(L, Index, MetatableName));
+        UObject* Object = Proxy->Object.Resolve();
+        if (!Object)
+        {
+            luaL_error(L, "Container of a destroyed object");
+        }
+
+        OutProperty = static_cast<const PropertyType*>(Proxy->Property);
+        return Proxy->Property->ContainerPtrToValuePtr<void>(Object);
+    }
+
+    // Look up a method in the proxy's method table (upvalue 1) for string keys; leaves it on the stack if found
+    bool PushMethod(lua_State* L)
+    {
+        if (lua_type(L, 2) != LUA_TSTRING)
+        {
+            return false;
+        }
+
+        lua_pushvalue(L, 2);
+        if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TNIL)
+        {
+            return true;
+        }
+        lua_pop(L, 1);
+        return false;
+    }
+
+    // Arrays
+
+    int Array_Index(lua_State* L)
+    {
+        if (PushMethod(L))
+        {
+            return 1;
+        }
+
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+
+        // Lua indices start at 1
+        const lua_Integer Index = lua_isinteger(L, 2) ? lua_tointeger(L, 2) - 1 : -1;
+        if (Index < 0 || Index >= Helper.Num())
+        {
+            lua_pushnil(L);
+            return 1;
+        }
+
+        FLuaPropertyMarshal::PushProperty(L, Property->Inner, Helper.GetRawPtr((int32)Index));
+        return 1;
+    }
+
+    int Array_NewIndex(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+
+        // Assigning one past the end appends, like a sequence
+        const lua_Integer Index = luaL_checkinteger(L, 2) - 1;
+        if (Index < 0 || Index > Helper.Num())
+        {
+            return luaL_error(L, "Array index %d out of range (1 to %d)", (int)(Index + 1), Helper.Num() + 1);
+        }
+
+        const bool bAppend = Index == Helper.Num();
+        if (bAppend)
+        {
+            Helper.AddValue();
+        }
+
+        if (!FLuaPropertyMarshal::ReadProperty(L, 3, Property->Inner, Helper.GetRawPtr((int32)Index)))
+        {
+            if (bAppend)
+            {
+                Helper.RemoveValues((int32)Index);
+            }
+            return luaL_error(L, "Cannot convert %s to an array element", luaL_typename(L, 3));
+        }
+        return 0;
+    }
+
+    int Array_Len(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+        lua_pushinteger(L, Helper.Num());
+        return 1;
+    }
+
+    // Stateless iterator, the control variable is the Lua index
+    int Array_Next(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+
+        const lua_Integer Index = luaL_checkinteger(L, 2);
+        if (Index >= Helper.Num())
+        {
+            return 0;
+        }
+
+        lua_pushinteger(L, Index + 1);
+        FLuaPropertyMarshal::PushProperty(L, Property->Inner, Helper.GetRawPtr((int32)Index));
+        return 2;
+    }
+
+    int Array_Pairs(lua_State* L)
+    {
+        luaL_checkudata(L, 1, ArrayMetatableName);
+        lua_pushcfunction(L, Array_Next);
+        lua_pushvalue(L, 1);
+        lua_pushinteger(L, 0);
+        return 3;
+    }
+
+    int Array_Add(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+
+        const int32 Index = Helper.AddValue();
+        if (!FLuaPropertyMarshal::ReadProperty(L, 2, Property->Inner, Helper.GetRawPtr(Index)))
+        {
+            Helper.RemoveValues(Index);
+            return luaL_error(L, "Cannot convert %s to an array element", luaL_typename(L, 2));
+        }
+
+        lua_pushinteger(L, Helper.Num());
+        return 1;
+    }
+
+    int Array_RemoveAt(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+
+        const lua_Integer Index = luaL_checkinteger(L, 2) - 1;
+        const bool bValid = Index >= 0 && Index < Helper.Num();
+        if (bValid)
+        {
+            Helper.RemoveValues((int32)Index);
+        }
+
+        lua_pushboolean(L, bValid);
+        return 1;
+    }
+
+    int Array_Clear(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FScriptArrayHelper Helper(Property, ValuePtr);
+        Helper.EmptyValues();
+        return 0;
+    }
+
+    int Array_ToTable(lua_State* L)
+    {
+        const FArrayProperty* Property;
+        const void* ValuePtr = CheckProxy(L, 1, ArrayMetatableName, Property);
+        FLuaContainerProxy::PushTable(L, Property, ValuePtr);
+        return 1;
+    }
+
+    // Maps
+
+    int Map_Index(lua_State* L)
+    {
+        if (PushMethod(L))
+        {
+            return 1;
+        }
+
+        const FMapProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, MapMetatableName, Property);
+        FScriptMapHelper Helper(Property, ValuePtr);
+
+        const uint8* FoundValue = nullptr;
+        {
+            FScopedValue Key(Property->KeyProp);
+            if (FLuaPropertyMarshal::ReadProperty(L, 2, Property->KeyProp, Key.Data))
+            {
+                FoundValue = Helper.FindValueFromHash(Key.Data);
+            }
+        }
+
+        if (!FoundValue)
+        {
+            lua_pushnil(L);
+            return 1;
+        }
+
+        FLuaPropertyMarshal::PushProperty(L, Property->ValueProp, FoundValue);
+        return 1;
+    }
+
+    int Map_NewIndex(lua_State* L)
+    {
+        const FMapProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, MapMetatableName, Property);
+        FScriptMapHelper Helper(Property, ValuePtr);
+
+        bool bConverted = false;
+        {
+            FScopedValue Key(Property->KeyProp);
+            bConverted = FLuaPropertyMarshal::ReadProperty(L, 2, Property->KeyProp, Key.Data);
+            if (bConverted)
+            {
+                // Assigning nil removes the pair, like a table
+                if (lua_isnil(L, 3))
+                {
+                    Helper.RemovePair(Key.Data);
+                }
+                else if (uint8* ExistingValue = Helper.FindValueFromHash(Key.Data))
+                {
+                    bConverted = FLuaPropertyMarshal::ReadProperty(L, 3, Property->ValueProp, ExistingValue);
+                }
+                else
+                {
+                    FScopedValue Value(Property->ValueProp);
+                    bConverted = FLuaPropertyMarshal::ReadProperty(L, 3, Property->ValueProp, Value.Data);
+                    if (bConverted)
+                    {
+                        Helper.AddPair(Key.Data, Value.Data);
+                    }
+                }
+            }
+        }
+
+        if (!bConverted)
+        {
+            return luaL_error(L, "Cannot convert %s = %s to a map pair", luaL_typename(L, 2), luaL_typename(L, 3));
+        }
+        return 0;
+    }
+
+    int Map_Len(lua_State* L)
+    {
+        const FMapProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, MapMetatableName, Property);
+        FScriptMapHelper Helper(Property, ValuePtr);
+        lua_pushinteger(L, Helper.Num());
+        return 1;
+    }
+
+    // Iterator closure, upvalue 1 is the next sparse index to visit
+    int Map_Next(lua_State* L)
+    {
+        const FMapProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, MapMetatableName, Property);
+        FScriptMapHelper Helper(Property, ValuePtr);
+
+        for (int32 Index = (int32)lua_tointeger(L, lua_upvalueindex(1)); Index < Helper.GetMaxIndex(); ++Index)
+        {
+            if (Helper.IsValidIndex(Index))
+            {
+                lua_pushinteger(L, Index + 1);
+                lua_replace(L, lua_upvalueindex(1));
+
+                FLuaPropertyMarshal::PushProperty(L, Property->KeyProp, Helper.GetKeyPtr(Index));
+                FLuaPropertyMarshal::PushProperty(L, Property->ValueProp, Helper.GetValuePtr(Index));
+                return 2;
+            }
+        }
+        return 0;
+    }
+
+    int Map_Pairs(lua_State* L)
+    {
+        luaL_checkudata(L, 1, MapMetatableName);
+        lua_pushinteger(L, 0);
+        lua_pushcclosure(L, Map_Next, 1);
+        lua_pushvalue(L, 1);
+        lua_pushnil(L);
+        return 3;
+    }
+
+    int Map_Clear(lua_State* L)
+    {
+        const FMapProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, MapMetatableName, Property);
+        FScriptMapHelper Helper(Property, ValuePtr);
+        Helper.EmptyValues();
+        return 0;
+    }
+
+    int Map_ToTable(lua_State* L)
+    {
+        const FMapProperty* Property;
+        const void* ValuePtr = CheckProxy(L, 1, MapMetatableName, Property);
+        FLuaContainerProxy::PushTable(L, Property, ValuePtr);
+        return 1;
+    }
+
+    // Sets
+
+    int Set_Index(lua_State* L)
+    {
+        if (PushMethod(L))
+        {
+            return 1;
+        }
+
+        const FSetProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, SetMetatableName, Property);
+        FScriptSetHelper Helper(Property, ValuePtr);
+
+        bool bContains = false;
+        {
+            FScopedValue Element(Property->ElementProp);
+            bContains = FLuaPropertyMarshal::ReadProperty(L, 2, Property->ElementProp, Element.Data) && Helper.FindElementIndex(Element.Data) != INDEX_NONE;
+        }
+
+        // Members read as true, like a table used as a set
+        if (bContains)
+        {
+            lua_pushboolean(L, true);
+        }
+        else
+        {
+            lua_pushnil(L);
+        }
+        return 1;
+    }
+
+    int Set_NewIndex(lua_State* L)
+    {
+        const FSetProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, SetMetatableName, Property);
+        FScriptSetHelper Helper(Property, ValuePtr);
+
+        bool bConverted = false;
+        {
+            FScopedValue Element(Property->ElementProp);
+            bConverted = FLuaPropertyMarshal::ReadProperty(L, 2, Property->ElementProp, Element.Data);
+            if (bConverted)
+            {
+                // set[x] = true adds, set[x] = nil (or false) removes
+                if (lua_toboolean(L, 3))
+                {
+                    Helper.AddElement(Element.Data);
+                }
+                else
+                {
+                    Helper.RemoveElement(Element.Data);
+                }
+            }
+        }
+
+        if (!bConverted)
+        {
+            return luaL_error(L, "Cannot convert %s to a set element", luaL_typename(L, 2));
+        }
+        return 0;
+    }
+
+    int Set_Len(lua_State* L)
+    {
+        const FSetProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, SetMetatableName, Property);
+        FScriptSetHelper Helper(Property, ValuePtr);
+        lua_pushinteger(L, Helper.Num());
+        return 1;
+    }
+
+    // Iterator closure, upvalue 1 is the next sparse index to visit
+    int Set_Next(lua_State* L)
+    {
+        const FSetProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, SetMetatableName, Property);
+        FScriptSetHelper Helper(Property, ValuePtr);
+
+        for (int32 Index = (int32)lua_tointeger(L, lua_upvalueindex(1)); Index < Helper.GetMaxIndex(); ++Index)
+        {
+            if (Helper.IsValidIndex(Index))
+            {
+                lua_pushinteger(L, Index + 1);
+                lua_replace(L, lua_upvalueindex(1));
+
+                FLuaPropertyMarshal::PushProperty(L, Property->ElementProp, Helper.GetElementPtr(Index));
+                lua_pushboolean(L, true);
+                return 2;
+            }
+        }
+        return 0;
+    }
+
+    int Set_Pairs(lua_State* L)
+    {
+        luaL_checkudata(L, 1, SetMetatableName);
+        lua_pushinteger(L, 0);
+        lua_pushcclosure(L, Set_Next, 1);
+        lua_pushvalue(L, 1);
+        lua_pushnil(L);
+        return 3;
+    }
+
+    int Set_Clear(lua_State* L)
+    {
+        const FSetProperty* Property;
+        void* ValuePtr = CheckProxy(L, 1, SetMetatableName, Property);
+        FScriptSetHelper Helper(Property, ValuePtr);
+        Helper.EmptyElements();
+        return 0;
+    }
+
+    int Set_ToTable(lua_State* L)
+    {
+        const FSetProperty* Property;
+        const void* ValuePtr = CheckProxy(L, 1, SetMetatableName, Property);
+        FLuaContainerProxy::PushTable(L, Property, ValuePtr);
+        return 1;
+    }
+
+    // Changes to the object's memory are recorded when made from a parallel tick
+    const luaL_Reg ArrayMethods[] =
+    {
+        { "Add", FLuaCommandBuffer::Deferrable<Array_Add> },
+        { "RemoveAt", FLuaCommandBuffer::Deferrable<Array_RemoveAt> },
+        { "Clear", FLuaCommandBuffer::Deferrable<Array_Clear> },
+        { "ToTable", Array_ToTable },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg MapMethods[] =
+    {
+        { "Clear", FLuaCommandBuffer::Deferrable<Map_Clear> },
+        { "ToTable", Map_ToTable },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg SetMethods[] =
+    {
+        { "Clear", FLuaCommandBuffer::Deferrable<Set_Clear> },
+        { "ToTable", Set_ToTable },
+        { nullptr, nullptr }
+    };
+
+    // Push the metatable of a proxy kind, creating it on first use; __index gets the method table as upvalue
+    void PushMetatable(lua_State* L, const char* MetatableName, const luaL_Reg* Methods, lua_CFunction Index, lua_CFunction NewIndex, lua_CFunction Len, lua_CFunction Pairs)
+    {
+        if (luaL_newmetatable(L, MetatableName))
+        {
+            lua_newtable(L);
+            luaL_setfuncs(L, Methods, 0);
+            lua_pushcclosure(L, Index, 1);
+            lua_setfield(L, -2, "__index");
+
+            lua_pushcfunction(L, NewIndex);
+            lua_setfield(L, -2, "__newindex");
+
+            lua_pushcfunction(L, Len);
+            lua_setfield(L, -2, "__len");
+
+            lua_pushcfunction(L, Pairs);
+            lua_setfield(L, -2, "__pairs");
+        }
+    }
+}
+
+bool FLuaContainerProxy::IsContainer(const FProperty* Property)
+{
+    return Property->IsA<FArrayProperty>() || Property->IsA<FMapProperty>() || Property->IsA<FSetProperty>();
+}
+
+void FLuaContainerProxy::Push(lua_State* L, UObject* Object, const FProperty* Property)
+{
+    using namespace LuaContainerProxy;
+
+    FProxy* Proxy = static_cast<FProxy*>(lua_newuserdatauv(L, sizeof(FProxy), 0));
+    new (Proxy) FProxy{ FLuaObjectHandle(Object), Property };
+
+    if (Property->IsA<FArrayProperty>())
+    {
+        PushMetatable(L, ArrayMetatableName, ArrayMethods, Array_Index, FLuaCommandBuffer::Deferrable<Array_NewIndex>, Array_Len, Array_Pairs);
+    }
+    else if (Property->IsA<FMapProperty>())
+    {
+        PushMetatable(L, MapMetatableName, MapMethods, Map_Index, FLuaCommandBuffer::Deferrable<Map_NewIndex>, Map_Len, Map_Pairs);
+    }
+    else
+    {
+        check(Property->IsA<FSetProperty>());
+        PushMetatable(L, SetMetatableName, SetMethods, Set_Index, FLuaCommandBuffer::Deferrable<Set_NewIndex>, Set_Len, Set_Pairs);
+    }
+    lua_setmetatable(L, -2);
+}
+
+bool FLuaContainerProxy::PushTable(lua_State* L, const FProperty* Property, const void* ValuePtr)
+{
+    luaL_checkstack(L, 4, "container too deeply nested");
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+        lua_createtable(L, Helper.Num(), 0);
+        for (int32 Index = 0; Index < Helper.Num(); ++Index)
+        {
+            FLuaPropertyMarshal::PushProperty(L, ArrayProperty->Inner, Helper.GetRawPtr(Index));
+            lua_rawseti(L, -2, Index + 1);
+        }
+    }
+    else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+    {
+        FScriptMapHelper Helper(MapProperty, ValuePtr);
+        lua_createtable(L, 0, Helper.Num());
+        for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+        {
+            if (!Helper.IsValidIndex(Index))
+            {
+                continue;
+            }
+
+            // Keys of unsupported types come out as nil and cannot be stored
+            if (!FLuaPropertyMarshal::PushProperty(L, MapProperty->KeyProp, Helper.GetKeyPtr(Index)))
+            {
+                lua_pop(L, 1);
+                continue;
+            }
+            FLuaPropertyMarshal::PushProperty(L, MapProperty->ValueProp, Helper.GetValuePtr(Index));
+            lua_rawset(L, -3);
+        }
+    }
+    else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+    {
+        FScriptSetHelper Helper(SetProperty, ValuePtr);
+        lua_createtable(L, 0, Helper.Num());
+        for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+        {
+            if (!Helper.IsValidIndex(Index))
+            {
+                continue;
+            }
+
+            if (!FLuaPropertyMarshal::PushProperty(L, SetProperty->ElementProp, Helper.GetElementPtr(Index)))
+            {
+                lua_pop(L, 1);
+                continue;
+            }
+            lua_pushboolean(L, true);
+            lua_rawset(L, -3);
+        }
+    }
+    else
+    {
+        lua_pushnil(L);
+        return false;
+    }
+
+    INC_DWORD_STAT(STAT_LuaContainerSnapshots);
+    return true;
+}
+
+bool FLuaContainerProxy::ReadTable(lua_State* L, int Index, const FProperty* Property, void* ValuePtr)
+{
+    using namespace LuaContainerProxy;
+
+    if (!lua_istable(L, Index))
+    {
+        return false;
+    }
+    Index = lua_absindex(L, Index);
+    luaL_checkstack(L, 4, "container too deeply nested");
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+        const int32 Num = (int32)lua_rawlen(L, Index);
+        Helper.EmptyValues(Num);
+        Helper.AddValues(Num);
+        for (int32 Element = 0; Element < Num; ++Element)
+        {
+            lua_rawgeti(L, Index, Element + 1);
+            FLuaPropertyMarshal::ReadProperty(L, -1, ArrayProperty->Inner, Helper.GetRawPtr(Element));
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+
+    if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+    {
+        FScriptMapHelper Helper(MapProperty, ValuePtr);
+        Helper.EmptyValues();
+
+        lua_pushnil(L);
+        while (lua_next(L, Index) != 0)
+        {
+            {
+                FScopedValue Key(MapProperty->KeyProp);
+                FScopedValue Value(MapProperty->ValueProp);
+                if (FLuaPropertyMarshal::ReadProperty(L, -2, MapProperty->KeyProp, Key.Data) && FLuaPropertyMarshal::ReadProperty(L, -1, MapProperty->ValueProp, Value.Data))
+                {
+                    Helper.AddPair(Key.Data, Value.Data);
+                }
+            }
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+
+    if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+    {
+        FScriptSetHelper Helper(SetProperty, ValuePtr);
+        Helper.EmptyElements();
+
+        lua_pushnil(L);
+        while (lua_next(L, Index) != 0)
+        {
+            if (lua_toboolean(L, -1))
+            {
+                FScopedValue Element(SetProperty->ElementProp);
+                if (FLuaPropertyMarshal::ReadProperty(L, -2, SetProperty->ElementProp, Element.Data))
+                {
+                    Helper.AddElement(Element.Data);
+                }
+            }
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+
+    return false;
+}
\ No newline at end of file
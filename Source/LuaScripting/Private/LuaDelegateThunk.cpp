@@ -0,0 +1,177 @@
+#include "LuaDelegateThunk.h"
+#include "LuaStateManager.h"
+#include "LuaStateContext.h"
+#include "LuaPropertyMarshal.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_CYCLE_STAT(TEXT("Delegate to Lua"), STAT_LuaDelegateCall, STATGROUP_LuaScripting);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bound delegates"), STAT_LuaBoundDelegates, STATGROUP_LuaScripting);
+
+namespace LuaDelegateThunk
+{
+    // Live thunks by handle; they are rooted while bound, so raw pointers are safe
+    TMap<uint32, ULuaDelegateThunk*> Thunks;
+    uint32 NextHandle = 1;
+
+    const FName BroadcastFunctionName(TEXT("OnDelegateBroadcast"));
+
+    FDelegateHandle PostGarbageCollectHandle;
+}
+
+uint32 ULuaDelegateThunk::Bind(lua_State* L, UObject* Target, FMulticastDelegateProperty* Property, int FunctionIndex)
+{
+    using namespace LuaDelegateThunk;
+
+    FLuaStateContext* Context = FLuaStateContext::Get(L);
+    if (!Context || !Target || !Property)
+    {
+        return 0;
+    }
+
+    // Targets die by garbage collection, sweep their thunks after each collection
+    if (!PostGarbageCollectHandle.IsValid())
+    {
+        PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&ULuaDelegateThunk::ReleaseStaleThunks);
+    }
+
+    ULuaDelegateThunk* Thunk = NewObject<ULuaDelegateThunk>(GetTransientPackage());
+    Thunk->AddToRoot();
+    Thunk->Handle = NextHandle++;
+    Thunk->Target = Target;
+    Thunk->Property = Property;
+    Thunk->Context = Context;
+    Thunk->ResetHandle = Context->OnReset.AddUObject(Thunk, &ULuaDelegateThunk::OnContextReset);
+
+    lua_pushvalue(L, FunctionIndex);
+    Thunk->FunctionRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    FScriptDelegate Delegate;
+    Delegate.BindUFunction(Thunk, BroadcastFunctionName);
+    Property->AddDelegate(MoveTemp(Delegate), Target);
+
+    Thunks.Add(Thunk->Handle, Thunk);
+    INC_DWORD_STAT(STAT_LuaBoundDelegates);
+    return Thunk->Handle;
+}
+
+bool ULuaDelegateThunk::Unbind(lua_State* L, uint32 Handle)
+{
+    // Handles of other states are not ours to remove
+    ULuaDelegateThunk** Thunk = LuaDelegateThunk::Thunks.Find(Handle);
+    if (!Thunk || (*Thunk)->Context != FLuaStateContext::Get(L))
+    {
+        return false;
+    }
+
+    ULuaDelegateThunk* Removed = *Thunk;
+    LuaDelegateThunk::Thunks.Remove(Handle);
+    Removed->Release();
+    return true;
+}
+
+int32 ULuaDelegateThunk::UnbindAll(lua_State* L, UObject* Target, FMulticastDelegateProperty* Property)
+{
+    const FLuaStateContext* Context = FLuaStateContext::Get(L);
+
+    int32 NumRemoved = 0;
+    for (auto It = LuaDelegateThunk::Thunks.CreateIterator(); It; ++It)
+    {
+        ULuaDelegateThunk* Thunk = It.Value();
+        if (Thunk->Context == Context && Thunk->Property == Property && Thunk->Target.Get() == Target)
+        {
+            It.RemoveCurrent();
+            Thunk->Release();
+            ++NumRemoved;
+        }
+    }
+    return NumRemoved;
+}
+
+void ULuaDelegateThunk::ProcessEvent(UFunction* Function, void* Parms)
+{
+    if (!Function || Function->GetFName() != LuaDelegateThunk::BroadcastFunctionName)
+    {
+        Super::ProcessEvent(Function, Parms);
+        return;
+    }
+
+    lua_State* L = Context ? Context->MainThread : nullptr;
+    if (!L || FunctionRef == LUA_NOREF)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LuaDelegateCall);
+
+    // The parameter memory is laid out by the delegate's signature, not by our placeholder
+    const int Top = lua_gettop(L);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, FunctionRef);
+    const int NumArgs = Parms ? FLuaPropertyMarshal::PushParameters(L, Property->SignatureFunction, Parms) : 0;
+
+    if (lua_pcall(L, NumArgs, 0, 0) != LUA_OK)
+    {
+        UE_LOG(LogLuaScripting, Error, TEXT("Lua error in %s handler: %s"), *Property->GetName(), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+    }
+    lua_settop(L, Top);
+}
+
+void ULuaDelegateThunk::OnDelegateBroadcast()
+{
+    // Never called directly, ProcessEvent handles the broadcast
+}
+
+void ULuaDelegateThunk::Release()
+{
+    if (UObject* TargetObject = Target.Get())
+    {
+        FScriptDelegate Delegate;
+        Delegate.BindUFunction(this, LuaDelegateThunk::BroadcastFunctionName);
+        Property->RemoveDelegate(Delegate, TargetObject);
+    }
+
+    if (Context)
+    {
+        Context->OnReset.Remove(ResetHandle);
+        if (Context->MainThread && FunctionRef != LUA_NOREF)
+        {
+            luaL_unref(Context->MainThread, LUA_REGISTRYINDEX, FunctionRef);
+        }
+    }
+
+    FunctionRef = LUA_NOREF;
+    Context = nullptr;
+    Target.Reset();
+
+    RemoveFromRoot();
+    MarkAsGarbage();
+    DEC_DWORD_STAT(STAT_LuaBoundDelegates);
+}
+
+void ULuaDelegateThunk::ReleaseStaleThunks()
+{
+    for (auto It = LuaDelegateThunk::Thunks.CreateIterator(); It; ++It)
+    {
+        ULuaDelegateThunk* Thunk = It.Value();
+        if (Thunk->Target.IsStale())
+        {
+            It.RemoveCurrent();
+            Thunk->Release();
+        }
+    }
+}
+
+void ULuaDelegateThunk::OnContextReset()
+{
+    // The reset delegate is cleared by the context after broadcasting
+    LuaDelegateThunk::Thunks.Remove(Handle);
+    ResetHandle.Reset();
+    Release();
+}
\ No newline at end of file
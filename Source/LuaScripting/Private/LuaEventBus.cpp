@@ -0,0 +1,272 @@
+#include "LuaEventBus.h"
+#include "LuaStateManager.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_CYCLE_STAT(TEXT("Event trigger"), STAT_LuaEventTrigger, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Event handlers called"), STAT_LuaEventHandlersCalled, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("Event queue flush"), STAT_LuaEventQueueFlush, STATGROUP_LuaScripting);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued events"), STAT_LuaQueuedEvents, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Coalesced events"), STAT_LuaCoalescedEvents, STATGROUP_LuaScripting);
+
+uint32 FLuaEventBus::Register(lua_State* L, FName Event, int HandlerIndex)
+{
+    int32 EventId = INDEX_NONE;
+    if (const int32* ExistingId = EventIds.Find(Event))
+    {
+        EventId = *ExistingId;
+    }
+    else
+    {
+        EventId = Events.AddDefaulted();
+        Events[EventId].Name = Event;
+        EventIds.Add(Event, EventId);
+    }
+
+    FHandler Handler;
+    Handler.Handle = NextHandle++;
+    lua_pushvalue(L, HandlerIndex);
+    Handler.Ref = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    FEvent& EventEntry = Events[EventId];
+    EventEntry.Handlers.Add(Handler);
+    if (EventEntry.NumLive++ == 0)
+    {
+        // Receive broadcasts from other states
+        FLuaStateManager::Get().AddEventSubscriber(L, Event);
+    }
+    HandlerEvents.Add(Handler.Handle, EventId);
+
+    return Handler.Handle;
+}
+
+bool FLuaEventBus::Unregister(lua_State* L, uint32 Handle)
+{
+    int32 EventId = INDEX_NONE;
+    if (!HandlerEvents.RemoveAndCopyValue(Handle, EventId))
+    {
+        return false;
+    }
+
+    FEvent& Event = Events[EventId];
+    const int32 HandlerIndex = Event.Handlers.IndexOfByPredicate([Handle](const FHandler& Handler) { return Handler.Handle == Handle; });
+    if (HandlerIndex != INDEX_NONE)
+    {
+        RemoveHandler(L, Event, HandlerIndex);
+    }
+
+    Compact();
+    return true;
+}
+
+int32 FLuaEventBus::UnregisterAll(lua_State* L, FName Event)
+{
+    const int32* EventId = EventIds.Find(Event);
+    if (!EventId)
+    {
+        return 0;
+    }
+
+    FEvent& EventEntry = Events[*EventId];
+    const int32 NumRemoved = EventEntry.NumLive;
+    for (int32 HandlerIndex = 0; HandlerIndex < EventEntry.Handlers.Num(); ++HandlerIndex)
+    {
+        if (EventEntry.Handlers[HandlerIndex].Ref != LUA_NOREF)
+        {
+            HandlerEvents.Remove(EventEntry.Handlers[HandlerIndex].Handle);
+            RemoveHandler(L, EventEntry, HandlerIndex);
+        }
+    }
+
+    Compact();
+    return NumRemoved;
+}
+
+int32 FLuaEventBus::Trigger(lua_State* L, FName Event, int FirstArg, int NumArgs)
+{
+    const int32* FoundId = EventIds.Find(Event);
+    if (!FoundId || Events[*FoundId].NumLive == 0)
+    {
+        return 0;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LuaEventTrigger);
+
+    const int32 EventId = *FoundId;
+    FirstArg = lua_absindex(L, FirstArg);
+    luaL_checkstack(L, NumArgs + 1, "too many event arguments");
+
+    // Handlers may register or remove handlers while we iterate; lists only grow until the outermost dispatch ends
+    ++DispatchDepth;
+
+    int32 NumCalled = 0;
+    const int32 NumHandlers = Events[EventId].Handlers.Num();
+    for (int32 HandlerIndex = 0; HandlerIndex < NumHandlers; ++HandlerIndex)
+    {
+        const int Ref = Events[EventId].Handlers[HandlerIndex].Ref;
+        if (Ref == LUA_NOREF)
+        {
+            continue;
+        }
+
+        lua_rawgeti(L, LUA_REGISTRYINDEX, Ref);
+        for (int Arg = 0; Arg < NumArgs; ++Arg)
+        {
+            lua_pushvalue(L, FirstArg + Arg);
+        }
+
+        if (lua_pcall(L, NumArgs, 0, 0) != LUA_OK)
+        {
+            UE_LOG(LogLuaScripting, Error, TEXT("Lua error in handler of event '%s': %s"), *Event.ToString(), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+            lua_pop(L, 1);
+        }
+        ++NumCalled;
+    }
+
+    --DispatchDepth;
+    Compact();
+
+    INC_DWORD_STAT_BY(STAT_LuaEventHandlersCalled, NumCalled);
+    return NumCalled;
+}
+
+bool FLuaEventBus::Post(lua_State* L, FName Event, int FirstArg, int NumArgs, FName CoalesceKey, const char*& OutError)
+{
+    int32 PayloadOffset = 0;
+    if (!QueuePayload.Append(L, FirstArg, NumArgs, PayloadOffset, OutError))
+    {
+        return false;
+    }
+
+    if (!CoalesceKey.IsNone())
+    {
+        // Keep the queue position of the first post, with the latest arguments; the old record is dropped at the flush
+        int32& QueueIndex = CoalescedEvents.FindOrAdd(TPair<FName, FName>(Event, CoalesceKey), INDEX_NONE);
+        if (QueueIndex != INDEX_NONE)
+        {
+            Queue[QueueIndex].PayloadOffset = PayloadOffset;
+            INC_DWORD_STAT(STAT_LuaCoalescedEvents);
+            return true;
+        }
+        QueueIndex = Queue.Num();
+    }
+
+    FQueuedEvent& Queued = Queue.AddDefaulted_GetRef();
+    Queued.Event = Event;
+    Queued.CoalesceKey = CoalesceKey;
+    Queued.PayloadOffset = PayloadOffset;
+    INC_DWORD_STAT(STAT_LuaQueuedEvents);
+    return true;
+}
+
+void FLuaEventBus::FlushQueue(lua_State* L)
+{
+    if (Queue.Num() == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LuaEventQueueFlush);
+    DEC_DWORD_STAT_BY(STAT_LuaQueuedEvents, Queue.Num());
+
+    Swap(Queue, FlushingQueue);
+    Swap(QueuePayload, FlushingPayload);
+    CoalescedEvents.Reset();
+
+    lua_pushcfunction(L, &FLuaEventBus::DispatchQueue);
+    lua_pushlightuserdata(L, this);
+    if (lua_pcall(L, 1, 0, 0) != LUA_OK)
+    {
+        UE_LOG(LogLuaScripting, Error, TEXT("Failed to dispatch queued Lua events: %s"), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+        lua_pop(L, 1);
+    }
+
+    FlushingQueue.Reset();
+    FlushingPayload.Reset();
+}
+
+int FLuaEventBus::DispatchQueue(lua_State* L)
+{
+    FLuaEventBus* Bus = static_cast<FLuaEventBus*>(lua_touserdata(L, 1));
+    lua_settop(L, 0);
+
+    // The queue is emptied if the state is reset by a handler
+    for (int32 Index = 0; Index < Bus->FlushingQueue.Num(); ++Index)
+    {
+        const FQueuedEvent& Queued = Bus->FlushingQueue[Index];
+        const int NumArgs = Bus->FlushingPayload.Push(L, Queued.PayloadOffset);
+        if (NumArgs == INDEX_NONE)
+        {
+            return luaL_error(L, "not enough stack space for the event values");
+        }
+
+        Bus->Trigger(L, Queued.Event, 1, NumArgs);
+        lua_settop(L, 0);
+    }
+    return 0;
+}
+
+bool FLuaEventBus::HasHandlers(FName Event) const
+{
+    const int32* EventId = EventIds.Find(Event);
+    return EventId && Events[*EventId].NumLive > 0;
+}
+
+void FLuaEventBus::Reset(lua_State* L)
+{
+    for (FEvent& Event : Events)
+    {
+        for (int32 HandlerIndex = 0; HandlerIndex < Event.Handlers.Num(); ++HandlerIndex)
+        {
+            if (Event.Handlers[HandlerIndex].Ref != LUA_NOREF)
+            {
+                RemoveHandler(L, Event, HandlerIndex);
+            }
+        }
+    }
+    HandlerEvents.Reset();
+
+    DEC_DWORD_STAT_BY(STAT_LuaQueuedEvents, Queue.Num());
+    Queue.Reset();
+    FlushingQueue.Reset();
+    QueuePayload.Reset();
+    FlushingPayload.Reset();
+    CoalescedEvents.Reset();
+
+    // Event ids are kept, the next script using the state likely triggers the same events
+    Compact();
+}
+
+void FLuaEventBus::RemoveHandler(lua_State* L, FEvent& Event, int32 HandlerIndex)
+{
+    FHandler& Handler = Event.Handlers[HandlerIndex];
+    luaL_unref(L, LUA_REGISTRYINDEX, Handler.Ref);
+    Handler.Ref = LUA_NOREF;
+    if (--Event.NumLive == 0)
+    {
+        FLuaStateManager::Get().RemoveEventSubscriber(L, Event.Name);
+    }
+    bHasTombstones = true;
+}
+
+void FLuaEventBus::Compact()
+{
+    if (DispatchDepth > 0 || !bHasTombstones)
+    {
+        return;
+    }
+
+    for (FEvent& Event : Events)
+    {
+        if (Event.NumLive < Event.Handlers.Num())
+        {
+            Event.Handlers.RemoveAll([](const FHandler& Handler) { return Handler.Ref == LUA_NOREF; });
+        }
+    }
+    bHasTombstones = false;
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "LuaEventPayload.h"
+#include "LuaBinding.h"
+#include "LuaValueTypes.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+namespace LuaEventPayload
+{
+    enum class EValueTag : uint8
+    {
+        Nil,
+        False,
+        True,
+        Integer,
+        Number,
+        String,
+        Object,
+        Vector,
+        Rotator,
+        Quat,
+        Transform,
+        Table,
+    };
+
+    // Nested tables deeper than this are rejected, which also stops cyclic tables
+    constexpr int32 MaxTableDepth = 16;
+}
+
+bool FLuaEventPayload::Append(lua_State* L, int FirstIndex, int NumValues, int32& OutOffset, const char*& OutError)
+{
+    FirstIndex = lua_absindex(L, FirstIndex);
+
+    const int32 NumBytes = Bytes.Num();
+    const int32 NumObjects = Objects.Num();
+
+    OutOffset = NumBytes;
+    Write<int32>(NumValues);
+    for (int Value = 0; Value < NumValues; ++Value)
+    {
+        if (!EncodeValue(L, FirstIndex + Value, 0, OutError))
+        {
+            // Drop the partial record
+            Bytes.SetNum(NumBytes, EAllowShrinking::No);
+            Objects.SetNum(NumObjects, EAllowShrinking::No);
+            return false;
+        }
+    }
+    return true;
+}
+
+int FLuaEventPayload::Push(lua_State* L, int32 Offset) const
+{
+    const int32 NumValues = Read<int32>(Offset);
+
+    // Reserve room for the values and the deepest table up front, decoding then can't raise a stack error
+    if (!lua_checkstack(L, NumValues + 3 * LuaEventPayload::MaxTableDepth))
+    {
+        return INDEX_NONE;
+    }
+    for (int32 Value = 0; Value < NumValues; ++Value)
+    {
+        DecodeValue(L, Offset);
+    }
+    return NumValues;
+}
+
+void FLuaEventPayload::Reset()
+{
+    Bytes.Reset();
+    Objects.Reset();
+}
+
+bool FLuaEventPayload::EncodeValue(lua_State* L, int Index, int32 Depth, const char*& OutError)
+{
+    using namespace LuaEventPayload;
+
+    switch (lua_type(L, Index))
+    {
+    case LUA_TNIL:
+        Write(EValueTag::Nil);
+        return true;
+
+    case LUA_TBOOLEAN:
+        Write(lua_toboolean(L, Index) ? EValueTag::True : EValueTag::False);
+        return true;
+
+    case LUA_TNUMBER:
+        if (lua_isinteger(L, Index))
+        {
+            Write(EValueTag::Integer);
+            Write<int64>(lua_tointeger(L, Index));
+        }
+        else
+        {
+            Write(EValueTag::Number);
+            Write<double>(lua_tonumber(L, Index));
+        }
+        return true;
+
+    case LUA_TSTRING:
+    {
+        // Strings stay UTF-8, both ends are Lua
+        size_t Length = 0;
+        const char* String = lua_tolstring(L, Index, &Length);
+        Write(EValueTag::String);
+        Write<int32>((int32)Length);
+        Bytes.Append(reinterpret_cast<const uint8*>(String), (int32)Length);
+        return true;
+    }
+
+    case LUA_TUSERDATA:
+        if (const FVector* Vector = FLuaValueTypes::ToVectorUserdata(L, Index))
+        {
+            Write(EValueTag::Vector);
+            Write(*Vector);
+            return true;
+        }
+        if (const FRotator* Rotator = FLuaValueTypes::ToRotatorUserdata(L, Index))
+        {
+            Write(EValueTag::Rotator);
+            Write(*Rotator);
+            return true;
+        }
+        if (const FQuat* Quat = FLuaValueTypes::ToQuatUserdata(L, Index))
+        {
+            Write(EValueTag::Quat);
+            Write(*Quat);
+            return true;
+        }
+        if (const FTransform* Transform = FLuaValueTypes::ToTransformUserdata(L, Index))
+        {
+            Write(EValueTag::Transform);
+            Write(Transform->GetLocation());
+            Write(Transform->GetRotation());
+            Write(Transform->GetScale3D());
+            return true;
+        }
+        if (UObject* Object = FLuaBinding::GetUObject(L, Index))
+        {
+            Write(EValueTag::Object);
+            Write<int32>(Objects.Add(Object));
+            return true;
+        }
+        OutError = "event values must not contain unsupported userdata";
+        return false;
+
+    case LUA_TTABLE:
+    {
+        if (Depth >= MaxTableDepth || !lua_checkstack(L, 3))
+        {
+            OutError = "event values contain tables nested too deeply (or cyclic tables)";
+            return false;
+        }
+
+        Index = lua_absindex(L, Index);
+        Write(EValueTag::Table);
+
+        // The pair count is patched in once the table has been walked
+        const int32 CountOffset = Bytes.Num();
+        Write<int32>(0);
+
+        int32 NumPairs = 0;
+        lua_pushnil(L);
+        while (lua_next(L, Index) != 0)
+        {
+            if (!EncodeValue(L, -2, Depth + 1, OutError) || !EncodeValue(L, -1, Depth + 1, OutError))
+            {
+                lua_pop(L, 2);
+                return false;
+            }
+            lua_pop(L, 1);
+            ++NumPairs;
+        }
+
+        FMemory::Memcpy(Bytes.GetData() + CountOffset, &NumPairs, sizeof(NumPairs));
+        return true;
+    }
+
+    default:
+        OutError = "event values must not contain functions or threads";
+        return false;
+    }
+}
+
+void FLuaEventPayload::DecodeValue(lua_State* L, int32& Offset) const
+{
+    using namespace LuaEventPayload;
+
+    switch (Read<EValueTag>(Offset))
+    {
+    case EValueTag::Nil:
+        lua_pushnil(L);
+        break;
+
+    case EValueTag::False:
+        lua_pushboolean(L, 0);
+        break;
+
+    case EValueTag::True:
+        lua_pushboolean(L, 1);
+        break;
+
+    case EValueTag::Integer:
+        lua_pushinteger(L, (lua_Integer)Read<int64>(Offset));
+        break;
+
+    case EValueTag::Number:
+        lua_pushnumber(L, Read<double>(Offset));
+        break;
+
+    case EValueTag::String:
+    {
+        const int32 Length = Read<int32>(Offset);
+        lua_pushlstring(L, reinterpret_cast<const char*>(Bytes.GetData() + Offset), Length);
+        Offset += Length;
+        break;
+    }
+
+    case EValueTag::Object:
+        // Objects destroyed since the event was sent arrive as nil
+        FLuaBinding::PushUObject(L, Objects[Read<int32>(Offset)].Get());
+        break;
+
+    case EValueTag::Vector:
+        FLuaValueTypes::PushVector(L, Read<FVector>(Offset));
+        break;
+
+    case EValueTag::Rotator:
+        FLuaValueTypes::PushRotator(L, Read<FRotator>(Offset));
+        break;
+
+    case EValueTag::Quat:
+        FLuaValueTypes::PushQuat(L, Read<FQuat>(Offset));
+        break;
+
+    case EValueTag::Transform:
+    {
+        const FVector Location = Read<FVector>(Offset);
+        const FQuat Rotation = Read<FQuat>(Offset);
+        const FVector Scale = Read<FVector>(Offset);
+        FLuaValueTypes::PushTransform(L, FTransform(Rotation, Location, Scale));
+        break;
+    }
+
+    case EValueTag::Table:
+    {
+        const int32 NumPairs = Read<int32>(Offset);
+        lua_createtable(L, 0, NumPairs);
+        for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+        {
+            DecodeValue(L, Offset);
+            DecodeValue(L, Offset);
+            if (lua_isnil(L, -2))
+            {
+                // The key was an object that has been destroyed
+                lua_pop(L, 2);
+            }
+            else
+            {
+                lua_rawset(L, -3);
+            }
+        }
+        break;
+    }
+    }
+}
\ No newline at end of file
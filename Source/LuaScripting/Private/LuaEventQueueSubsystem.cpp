@@ -0,0 +1,120 @@
+#include "LuaEventQueueSubsystem.h"
+#include "LuaStateManager.h"
+#include "LuaStateContext.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarLuaEventFlushTickGroup(
+    TEXT("lua.Event.FlushTickGroup"),
+    TG_PostUpdateWork,
+    TEXT("Tick group (ETickingGroup value) in which events queued with UE.Event.Post are dispatched, read when a world begins play"));
+
+void FLuaEventQueueTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem)
+    {
+        Subsystem->Flush();
+    }
+}
+
+FString FLuaEventQueueTickFunction::DiagnosticMessage()
+{
+    return TEXT("FLuaEventQueueTickFunction");
+}
+
+void ULuaEventQueueSubsystem::Deinitialize()
+{
+    if (FlushTickFunction.IsTickFunctionRegistered())
+    {
+        FlushTickFunction.UnRegisterTickFunction();
+    }
+
+    for (const TPair<FLuaStateContext*, FDelegateHandle>& Pair : PendingContexts)
+    {
+        Pair.Key->OnReset.Remove(Pair.Value);
+    }
+    PendingContexts.Empty();
+
+    Super::Deinitialize();
+}
+
+void ULuaEventQueueSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    const int32 TickGroup = FMath::Clamp(CVarLuaEventFlushTickGroup.GetValueOnGameThread(), (int32)TG_PrePhysics, (int32)TG_LastDemotable - 1);
+
+    // Events are game-thread only, they call into Lua
+    FlushTickFunction.Subsystem = this;
+    FlushTickFunction.bCanEverTick = true;
+    FlushTickFunction.bStartWithTickEnabled = true;
+    FlushTickFunction.bRunOnAnyThread = false;
+    FlushTickFunction.TickGroup = (ETickingGroup)TickGroup;
+    FlushTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+bool ULuaEventQueueSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULuaEventQueueSubsystem::MarkPending(lua_State* L)
+{
+    FLuaStateContext* Context = FLuaStateContext::Get(L);
+    if (!Context || PendingContexts.Contains(Context))
+    {
+        return;
+    }
+
+    // Forget the state if it is pooled or closed before the flush
+    PendingContexts.Add(Context, Context->OnReset.AddUObject(this, &ULuaEventQueueSubsystem::OnContextReset, Context));
+}
+
+void ULuaEventQueueSubsystem::Flush()
+{
+    if (PendingContexts.Num() == 0)
+    {
+        return;
+    }
+
+    // Reset listeners stay bound until a context is flushed, handlers may reset the states after their own
+    FlushingContexts.Reset();
+    for (const TPair<FLuaStateContext*, FDelegateHandle>& Pair : PendingContexts)
+    {
+        FlushingContexts.Add(Pair.Key);
+    }
+
+    for (int32 Index = 0; Index < FlushingContexts.Num(); ++Index)
+    {
+        FLuaStateContext* Context = FlushingContexts[Index];
+        if (!Context)
+        {
+            continue;
+        }
+
+        // A state posting from its own handlers is marked again and flushed next frame
+        FDelegateHandle ResetHandle;
+        PendingContexts.RemoveAndCopyValue(Context, ResetHandle);
+        Context->OnReset.Remove(ResetHandle);
+
+        if (Context->MainThread)
+        {
+            Context->Events.FlushQueue(Context->MainThread);
+        }
+    }
+    FlushingContexts.Reset();
+}
+
+void ULuaEventQueueSubsystem::OnContextReset(FLuaStateContext* Context)
+{
+    PendingContexts.Remove(Context);
+
+    for (FLuaStateContext*& FlushingContext : FlushingContexts)
+    {
+        if (FlushingContext == Context)
+        {
+            FlushingContext = nullptr;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "LuaLogSink.h"
+#include "LuaStateManager.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarLuaLogMaxOnScreenPerFrame(
+    TEXT("lua.Log.MaxOnScreenPerFrame"),
+    8,
+    TEXT("Maximum number of Lua messages added to the on-screen debug log per frame, the rest only go to the output log"));
+
+FLuaLogSink& FLuaLogSink::Get()
+{
+    static FLuaLogSink Instance;
+    return Instance;
+}
+
+FLuaLogSink::FLuaLogSink()
+    : Slots(MakeUnique<FSlot[]>(Capacity))
+    , EnqueuePos(0)
+    , DequeuePos(0)
+    , NumDropped(0)
+{
+    for (uint32 Index = 0; Index < Capacity; ++Index)
+    {
+        Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+    }
+}
+
+void FLuaLogSink::Startup()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLuaLogSink::Tick));
+    }
+}
+
+void FLuaLogSink::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    Flush();
+}
+
+bool FLuaLogSink::IsActive(ELogVerbosity::Type Verbosity, bool bOnScreen)
+{
+    return bOnScreen || !LogLuaScripting.IsSuppressed(Verbosity);
+}
+
+bool FLuaLogSink::Enqueue(ELogVerbosity::Type Verbosity, bool bOnScreen, const char* Utf8Message, int32 Length)
+{
+    // Claim a slot (bounded multi-producer ring, each slot's sequence tells whether it is free for this lap)
+    uint32 Pos = EnqueuePos.load(std::memory_order_relaxed);
+    FSlot* Slot = nullptr;
+    for (;;)
+    {
+        Slot = &Slots[Pos & (Capacity - 1)];
+        const uint32 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+        const int32 Difference = (int32)(Sequence - Pos);
+
+        if (Difference == 0)
+        {
+            if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (Difference < 0)
+        {
+            // Ring is full
+            NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            Pos = EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    FEntry& Entry = Slot->Entry;
+    Entry.Verbosity = Verbosity;
+    Entry.bOnScreen = bOnScreen;
+    Entry.Message.SetNumUninitialized(Length + 1, EAllowShrinking::No);
+    FMemory::Memcpy(Entry.Message.GetData(), Utf8Message, Length);
+    Entry.Message[Length] = '\0';
+
+    // Publish the slot to the consumer
+    Slot->Sequence.store(Pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool FLuaLogSink::Dequeue(FEntry& OutEntry)
+{
+    FSlot& Slot = Slots[DequeuePos & (Capacity - 1)];
+    const uint32 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+    if ((int32)(Sequence - (DequeuePos + 1)) < 0)
+    {
+        // Nothing published yet
+        return false;
+    }
+
+    OutEntry.Verbosity = Slot.Entry.Verbosity;
+    OutEntry.bOnScreen = Slot.Entry.bOnScreen;
+    Swap(OutEntry.Message, Slot.Entry.Message);
+
+    // Hand the slot back to producers for the next lap
+    Slot.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+    ++DequeuePos;
+    return true;
+}
+
+void FLuaLogSink::Flush()
+{
+    check(IsInGameThread());
+
+    int32 NumOnScreen = 0;
+    int32 RepeatCount = 0;
+
+    while (Dequeue(Current))
+    {
+        // Coalesce runs of identical messages into one line
+        if (RepeatCount > 0
+            && Current.Verbosity == Pending.Verbosity
+            && Current.bOnScreen == Pending.bOnScreen
+            && Current.Message.Num() == Pending.Message.Num()
+            && FMemory::Memcmp(Current.Message.GetData(), Pending.Message.GetData(), Current.Message.Num()) == 0)
+        {
+            ++RepeatCount;
+            continue;
+        }
+
+        if (RepeatCount > 0)
+        {
+            Emit(Pending, RepeatCount, NumOnScreen);
+        }
+
+        Swap(Current, Pending);
+        RepeatCount = 1;
+    }
+
+    if (RepeatCount > 0)
+    {
+        Emit(Pending, RepeatCount, NumOnScreen);
+    }
+
+    const int32 Dropped = NumDropped.exchange(0, std::memory_order_relaxed);
+    if (Dropped > 0)
+    {
+        UE_LOG(LogLuaScripting, Warning, TEXT("[Lua] %d log messages dropped (log buffer full)"), Dropped);
+    }
+}
+
+void FLuaLogSink::Emit(const FEntry& Entry, int32 RepeatCount, int32& NumOnScreen)
+{
+    const FString Message = RepeatCount > 1
+        ? FString::Printf(TEXT("%s (x%d)"), UTF8_TO_TCHAR(Entry.Message.GetData()), RepeatCount)
+        : FString(UTF8_TO_TCHAR(Entry.Message.GetData()));
+
+    switch (Entry.Verbosity)
+    {
+    case ELogVerbosity::Error:
+        UE_LOG(LogLuaScripting, Error, TEXT("[Lua] %s"), *Message);
+        break;
+    case ELogVerbosity::Warning:
+        UE_LOG(LogLuaScripting, Warning, TEXT("[Lua] %s"), *Message);
+        break;
+    case ELogVerbosity::Display:
+        UE_LOG(LogLuaScripting, Display, TEXT("[Lua] %s"), *Message);
+        break;
+    default:
+        UE_LOG(LogLuaScripting, Log, TEXT("[Lua] %s"), *Message);
+        break;
+    }
+
+    if (Entry.bOnScreen && GEngine && NumOnScreen < CVarLuaLogMaxOnScreenPerFrame.GetValueOnGameThread())
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, Message);
+        ++NumOnScreen;
+    }
+}
+
+bool FLuaLogSink::Tick(float DeltaTime)
+{
+    Flush();
+
+    // Keep ticking
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,390 @@
+#include "LuaMathKernels.h"
+#include "LuaStateManager.h"
+#include "LuaValueTypes.h"
+#include "LuaBuffer.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+void FLuaMathKernels::Lerp(TArrayView<const float> A, TArrayView<const float> B, float Alpha, TArrayView<float> Out)
+{
+    check(A.Num() == B.Num() && Out.Num() >= A.Num());
+
+    const int32 Num = A.Num();
+    const VectorRegister4Float AlphaReg = VectorSetFloat1(Alpha);
+
+    int32 Index = 0;
+    for (; Index + 4 <= Num; Index += 4)
+    {
+        const VectorRegister4Float ValueA = VectorLoad(A.GetData() + Index);
+        const VectorRegister4Float ValueB = VectorLoad(B.GetData() + Index);
+        VectorStore(VectorMultiplyAdd(VectorSubtract(ValueB, ValueA), AlphaReg, ValueA), Out.GetData() + Index);
+    }
+
+    // Remaining elements
+    for (; Index < Num; ++Index)
+    {
+        Out[Index] = A[Index] + (B[Index] - A[Index]) * Alpha;
+    }
+}
+
+void FLuaMathKernels::AddScaled(TArrayView<const float> A, TArrayView<const float> B, float Scale, TArrayView<float> Out)
+{
+    check(A.Num() == B.Num() && Out.Num() >= A.Num());
+
+    const int32 Num = A.Num();
+    const VectorRegister4Float ScaleReg = VectorSetFloat1(Scale);
+
+    int32 Index = 0;
+    for (; Index + 4 <= Num; Index += 4)
+    {
+        const VectorRegister4Float ValueA = VectorLoad(A.GetData() + Index);
+        const VectorRegister4Float ValueB = VectorLoad(B.GetData() + Index);
+        VectorStore(VectorMultiplyAdd(ValueB, ScaleReg, ValueA), Out.GetData() + Index);
+    }
+
+    // Remaining elements
+    for (; Index < Num; ++Index)
+    {
+        Out[Index] = A[Index] + B[Index] * Scale;
+    }
+}
+
+void FLuaMathKernels::Scale(TArrayView<const float> A, float Scale, TArrayView<float> Out)
+{
+    check(Out.Num() >= A.Num());
+
+    const int32 Num = A.Num();
+    const VectorRegister4Float ScaleReg = VectorSetFloat1(Scale);
+
+    int32 Index = 0;
+    for (; Index + 4 <= Num; Index += 4)
+    {
+        VectorStore(VectorMultiply(VectorLoad(A.GetData() + Index), ScaleReg), Out.GetData() + Index);
+    }
+
+    // Remaining elements
+    for (; Index < Num; ++Index)
+    {
+        Out[Index] = A[Index] * Scale;
+    }
+}
+
+void FLuaMathKernels::Normalize(TArrayView<const float> Vectors, TArrayView<float> Out)
+{
+    check(Vectors.Num() % 3 == 0 && Out.Num() >= Vectors.Num());
+
+    const VectorRegister4Float Tolerance = VectorSetFloat1(UE_SMALL_NUMBER);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    for (int32 Index = 0; Index < Vectors.Num(); Index += 3)
+    {
+        const VectorRegister4Float Value = VectorLoadFloat3(Vectors.GetData() + Index);
+        const VectorRegister4Float SizeSquared = VectorDot3(Value, Value);
+        const VectorRegister4Float Normal = VectorMultiply(Value, VectorReciprocalSqrtAccurate(SizeSquared));
+        VectorStoreFloat3(VectorSelect(VectorCompareGT(SizeSquared, Tolerance), Normal, Zero), Out.GetData() + Index);
+    }
+}
+
+void FLuaMathKernels::DistanceToPoint(TArrayView<const float> Vectors, const FVector3f& Point, TArrayView<float> OutDistances)
+{
+    check(Vectors.Num() % 3 == 0 && OutDistances.Num() >= Vectors.Num() / 3);
+
+    const VectorRegister4Float PointReg = VectorLoadFloat3(&Point.X);
+
+    for (int32 Index = 0; Index < Vectors.Num(); Index += 3)
+    {
+        const VectorRegister4Float Delta = VectorSubtract(VectorLoadFloat3(Vectors.GetData() + Index), PointReg);
+        float DistanceSquared;
+        VectorStoreFloat1(VectorDot3(Delta, Delta), &DistanceSquared);
+        OutDistances[Index / 3] = FMath::Sqrt(DistanceSquared);
+    }
+}
+
+void FLuaMathKernels::TransformPositions(TArrayView<const float> Vectors, const FMatrix44f& Matrix, TArrayView<float> Out)
+{
+    check(Vectors.Num() % 3 == 0 && Out.Num() >= Vectors.Num());
+
+    const VectorRegister4Float Row0 = VectorLoad(&Matrix.M[0][0]);
+    const VectorRegister4Float Row1 = VectorLoad(&Matrix.M[1][0]);
+    const VectorRegister4Float Row2 = VectorLoad(&Matrix.M[2][0]);
+    const VectorRegister4Float Row3 = VectorLoad(&Matrix.M[3][0]);
+
+    for (int32 Index = 0; Index < Vectors.Num(); Index += 3)
+    {
+        const VectorRegister4Float Value = VectorLoadFloat3(Vectors.GetData() + Index);
+
+        // X * Row0 + Y * Row1 + Z * Row2 + Row3
+        VectorRegister4Float Result = VectorMultiplyAdd(VectorReplicate(Value, 2), Row2, Row3);
+        Result = VectorMultiplyAdd(VectorReplicate(Value, 1), Row1, Result);
+        Result = VectorMultiplyAdd(VectorReplicate(Value, 0), Row0, Result);
+
+        VectorStoreFloat3(Result, Out.GetData() + Index);
+    }
+}
+
+namespace LuaMathKernels
+{
+    /**
+     * Per-thread conversion buffers, reused between calls so steady-state calls do not allocate
+     * (and so nothing leaks when a Lua error unwinds past the binding)
+     */
+    struct FScratch
+    {
+        TArray<float> A;
+        TArray<float> B;
+        TArray<float> Out;
+    };
+
+    FScratch& GetScratch()
+    {
+        static thread_local FScratch Scratch;
+        return Scratch;
+    }
+
+    // Read a float32 buffer in place, or convert another buffer type or a flat array of numbers into Storage
+    TArrayView<const float> CheckFloats(lua_State* L, int Index, TArray<float>& Storage)
+    {
+        if (FLuaBuffer* Buffer = FLuaBuffer::ToBuffer(L, Index))
+        {
+            if (Buffer->GetType() == ELuaBufferType::Float32)
+            {
+                return Buffer->GetFloat32View();
+            }
+
+            Storage.SetNumUninitialized(Buffer->Num(), EAllowShrinking::No);
+            for (int32 Element = 0; Element < Buffer->Num(); ++Element)
+            {
+                Storage[Element] = (float)Buffer->GetElement(Element);
+            }
+            return Storage;
+        }
+
+        luaL_argexpected(L, lua_istable(L, Index), Index, "Buffer or table");
+
+        const int32 Num = (int32)lua_rawlen(L, Index);
+        Storage.SetNumUninitialized(Num, EAllowShrinking::No);
+        for (int32 Element = 0; Element < Num; ++Element)
+        {
+            lua_rawgeti(L, Index, Element + 1);
+            Storage[Element] = (float)lua_tonumber(L, -1);
+            lua_pop(L, 1);
+        }
+
+        return Storage;
+    }
+
+    // Read a flat array of packed X, Y, Z vectors
+    TArrayView<const float> CheckVectors(lua_State* L, int Index, TArray<float>& Storage)
+    {
+        TArrayView<const float> Values = CheckFloats(L, Index, Storage);
+        if (Values.Num() % 3 != 0)
+        {
+            luaL_argerror(L, Index, "expected packed X, Y, Z values (length must be a multiple of 3)");
+        }
+        return Values;
+    }
+
+    /** Where a kernel writes its results */
+    struct FKernelOutput
+    {
+        /** View the kernel writes into */
+        TArrayView<float> View;
+
+        /** Stack index of the buffer holding the results, or 0 if the results are copied into a table */
+        int BufferIndex = 0;
+    };
+
+    /**
+     * Get the output for Num results
+     * A float32 buffer passed as out is written in place, a table passed as out is filled afterwards,
+     * and without out the result is a new buffer if the first input was a buffer, otherwise a new table
+     */
+    FKernelOutput PrepareOutput(lua_State* L, int OutIndex, int32 Num, TArray<float>& Storage)
+    {
+        FKernelOutput Output;
+
+        if (FLuaBuffer* Buffer = FLuaBuffer::ToBuffer(L, OutIndex))
+        {
+            luaL_argcheck(L, Buffer->GetType() == ELuaBufferType::Float32 && Buffer->Num() == Num, OutIndex, "out buffer must be float32 with matching length");
+            Output.View = Buffer->GetFloat32View();
+            Output.BufferIndex = OutIndex;
+            return Output;
+        }
+
+        if (lua_isnoneornil(L, OutIndex) && FLuaBuffer::ToBuffer(L, 1))
+        {
+            Output.View = FLuaBuffer::Push(L, ELuaBufferType::Float32, Num)->GetFloat32View();
+            Output.BufferIndex = lua_gettop(L);
+            return Output;
+        }
+
+        if (!lua_isnoneornil(L, OutIndex))
+        {
+            luaL_argexpected(L, lua_istable(L, OutIndex), OutIndex, "Buffer or table");
+        }
+
+        Storage.SetNumUninitialized(Num, EAllowShrinking::No);
+        Output.View = Storage;
+        return Output;
+    }
+
+    // Push the results, filling the caller's table at OutIndex if one was given
+    void FinishOutput(lua_State* L, int OutIndex, const FKernelOutput& Output)
+    {
+        if (Output.BufferIndex != 0)
+        {
+            lua_pushvalue(L, Output.BufferIndex);
+            return;
+        }
+
+        const TArrayView<const float> Values = Output.View;
+
+        int32 PreviousNum = 0;
+        if (lua_istable(L, OutIndex))
+        {
+            PreviousNum = (int32)lua_rawlen(L, OutIndex);
+            lua_pushvalue(L, OutIndex);
+        }
+        else
+        {
+            lua_createtable(L, Values.Num(), 0);
+        }
+
+        for (int32 Element = 0; Element < Values.Num(); ++Element)
+        {
+            lua_pushnumber(L, Values[Element]);
+            lua_rawseti(L, -2, Element + 1);
+        }
+
+        // Trim stale entries when reusing a longer table
+        for (int32 Element = PreviousNum; Element > Values.Num(); --Element)
+        {
+            lua_pushnil(L);
+            lua_rawseti(L, -2, Element);
+        }
+    }
+
+    FMatrix44f CheckMatrix(lua_State* L, int Index)
+    {
+        FTransform Transform;
+        if (FLuaValueTypes::GetTransform(L, Index, Transform))
+        {
+            return FMatrix44f(Transform.ToMatrixWithScale());
+        }
+
+        // Otherwise expect 16 numbers in row-major order
+        luaL_argcheck(L, lua_istable(L, Index) && lua_rawlen(L, Index) == 16, Index, "expected FTransform or 16 matrix values");
+
+        FMatrix44f Matrix;
+        for (int32 Element = 0; Element < 16; ++Element)
+        {
+            lua_rawgeti(L, Index, Element + 1);
+            Matrix.M[Element / 4][Element % 4] = (float)lua_tonumber(L, -1);
+            lua_pop(L, 1);
+        }
+        return Matrix;
+    }
+
+    // UE.Math.LerpVectors(a, b, alpha[, out])
+    int Lua_LerpVectors(lua_State* L)
+    {
+        FScratch& Scratch = GetScratch();
+        TArrayView<const float> A = CheckFloats(L, 1, Scratch.A);
+        TArrayView<const float> B = CheckFloats(L, 2, Scratch.B);
+        const float Alpha = (float)luaL_checknumber(L, 3);
+        luaL_argcheck(L, A.Num() == B.Num(), 2, "arrays must have the same length");
+
+        const FKernelOutput Out = PrepareOutput(L, 4, A.Num(), Scratch.Out);
+        FLuaMathKernels::Lerp(A, B, Alpha, Out.View);
+        FinishOutput(L, 4, Out);
+        return 1;
+    }
+
+    // UE.Math.AddScaledVectors(a, b, scale[, out])
+    int Lua_AddScaledVectors(lua_State* L)
+    {
+        FScratch& Scratch = GetScratch();
+        TArrayView<const float> A = CheckFloats(L, 1, Scratch.A);
+        TArrayView<const float> B = CheckFloats(L, 2, Scratch.B);
+        const float Scale = (float)luaL_optnumber(L, 3, 1.0);
+        luaL_argcheck(L, A.Num() == B.Num(), 2, "arrays must have the same length");
+
+        const FKernelOutput Out = PrepareOutput(L, 4, A.Num(), Scratch.Out);
+        FLuaMathKernels::AddScaled(A, B, Scale, Out.View);
+        FinishOutput(L, 4, Out);
+        return 1;
+    }
+
+    // UE.Math.ScaleVectors(a, scale[, out])
+    int Lua_ScaleVectors(lua_State* L)
+    {
+        FScratch& Scratch = GetScratch();
+        TArrayView<const float> A = CheckFloats(L, 1, Scratch.A);
+        const float Scale = (float)luaL_checknumber(L, 2);
+
+        const FKernelOutput Out = PrepareOutput(L, 3, A.Num(), Scratch.Out);
+        FLuaMathKernels::Scale(A, Scale, Out.View);
+        FinishOutput(L, 3, Out);
+        return 1;
+    }
+
+    // UE.Math.NormalizeVectors(a[, out])
+    int Lua_NormalizeVectors(lua_State* L)
+    {
+        FScratch& Scratch = GetScratch();
+        TArrayView<const float> Vectors = CheckVectors(L, 1, Scratch.A);
+
+        const FKernelOutput Out = PrepareOutput(L, 2, Vectors.Num(), Scratch.Out);
+        FLuaMathKernels::Normalize(Vectors, Out.View);
+        FinishOutput(L, 2, Out);
+        return 1;
+    }
+
+    // UE.Math.DistancesToPoint(a, point[, out])
+    int Lua_DistancesToPoint(lua_State* L)
+    {
+        FScratch& Scratch = GetScratch();
+        TArrayView<const float> Vectors = CheckVectors(L, 1, Scratch.A);
+        const FVector3f Point(FLuaValueTypes::CheckVector(L, 2));
+
+        const FKernelOutput Out = PrepareOutput(L, 3, Vectors.Num() / 3, Scratch.Out);
+        FLuaMathKernels::DistanceToPoint(Vectors, Point, Out.View);
+        FinishOutput(L, 3, Out);
+        return 1;
+    }
+
+    // UE.Math.TransformPositions(a, transform[, out])
+    int Lua_TransformPositions(lua_State* L)
+    {
+        FScratch& Scratch = GetScratch();
+        TArrayView<const float> Vectors = CheckVectors(L, 1, Scratch.A);
+        const FMatrix44f Matrix = CheckMatrix(L, 2);
+
+        const FKernelOutput Out = PrepareOutput(L, 3, Vectors.Num(), Scratch.Out);
+        FLuaMathKernels::TransformPositions(Vectors, Matrix, Out.View);
+        FinishOutput(L, 3, Out);
+        return 1;
+    }
+}
+
+void FLuaMathKernels::Register(lua_State* L)
+{
+    using namespace LuaMathKernels;
+
+    static const luaL_Reg Kernels[] = {
+        { "LerpVectors", Lua_LerpVectors },
+        { "AddScaledVectors", Lua_AddScaledVectors },
+        { "ScaleVectors", Lua_ScaleVectors },
+        { "NormalizeVectors", Lua_NormalizeVectors },
+        { "DistancesToPoint", Lua_DistancesToPoint },
+        { "TransformPositions", Lua_TransformPositions },
+        { nullptr, nullptr }
+    };
+
+    luaL_setfuncs(L, Kernels, 0);
+}
\ No newline at end of file
@@ -0,0 +1,616 @@
+#include "LuaPropertyMarshal.h"
+#include "LuaBinding.h"
+#include "LuaContainerProxy.h"
+#include "LuaStringBridge.h"
+#include "LuaValueTypes.h"
+#include "LuaStateManager.h"
+#include "LuaCommandBuffer.h"
+#include "UObject/UnrealType.h"
+#include "UObject/TextProperty.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Struct plans built"), STAT_LuaStructPlansBuilt, STATGROUP_LuaScripting);
+
+// Registry key of the per-state table holding the interned field names of every struct plan; not const, so its address
+// stays unique
+static char StructFieldNamesKey = 0;
+
+namespace LuaPropertyMarshal
+{
+    // Converter of a struct field, resolved once when the plan is built
+    enum class EFieldKind : uint8
+    {
+        Bool,
+        Integer,
+        Float,
+        Double,
+        Enum,
+        Object,
+        Name,
+        String,
+        Text,
+        Vector,
+        Rotator,
+        Quat,
+        Transform,
+        Struct,
+        Container,
+    };
+
+    struct FStructPlan;
+
+    struct FFieldPlan
+    {
+        const FProperty* Property;
+        int32 Offset;
+        EFieldKind Kind;
+
+        // Plan of nested structs, owned by the plan cache
+        const FStructPlan* Nested;
+    };
+
+    struct FStructPlan
+    {
+        // Key of the interned field names in each Lua state; never reused, unlike the plan's address
+        int32 Id;
+
+        // Detect structs that were unloaded or recompiled (user defined structs) since the plan was built
+        TWeakObjectPtr<const UScriptStruct> Struct;
+        const FProperty* PropertyLink;
+
+        TArray<FFieldPlan> Fields;
+
+        // UTF-8 field names, interned in each Lua state on first use
+        TArray<TArray<ANSICHAR>> FieldNames;
+    };
+
+    // Locked for the scripts of a parallel tick; plans are never freed, so a plan found under the lock stays valid
+    // after it is released, and for callers up the stack while nested fields rebuild stale plans
+    TMap<const UScriptStruct*, TUniquePtr<FStructPlan>> Plans;
+
+    // Plans replaced after a struct was recompiled, kept alive for the callers still using them
+    TArray<TUniquePtr<FStructPlan>> RetiredPlans;
+    int32 NextPlanId = 1;
+    FCriticalSection PlansLock;
+
+    const FStructPlan& FindOrBuildPlan(const UScriptStruct* Struct);
+
+    // Kind of a value type struct, or Struct for any other struct
+    // Derived value types without extra members (FVector_NetQuantize, ...) convert like their base
+    EFieldKind GetStructKind(const UScriptStruct* Struct)
+    {
+        if (Struct->IsChildOf(TBaseStructure<FVector>::Get()))
+        {
+            return EFieldKind::Vector;
+        }
+        if (Struct->IsChildOf(TBaseStructure<FRotator>::Get()))
+        {
+            return EFieldKind::Rotator;
+        }
+        if (Struct->IsChildOf(TBaseStructure<FQuat>::Get()))
+        {
+            return EFieldKind::Quat;
+        }
+        if (Struct->IsChildOf(TBaseStructure<FTransform>::Get()))
+        {
+            return EFieldKind::Transform;
+        }
+        return EFieldKind::Struct;
+    }
+
+    bool ClassifyProperty(const FProperty* Property, EFieldKind& OutKind)
+    {
+        if (CastField<FBoolProperty>(Property))
+        {
+            OutKind = EFieldKind::Bool;
+        }
+        else if (CastField<FEnumProperty>(Property))
+        {
+            OutKind = EFieldKind::Enum;
+        }
+        else if (CastField<FFloatProperty>(Property))
+        {
+            OutKind = EFieldKind::Float;
+        }
+        else if (CastField<FDoubleProperty>(Property))
+        {
+            OutKind = EFieldKind::Double;
+        }
+        else if (CastField<FNumericProperty>(Property))
+        {
+            OutKind = EFieldKind::Integer;
+        }
+        else if (CastField<FObjectPropertyBase>(Property))
+        {
+            OutKind = EFieldKind::Object;
+        }
+        else if (CastField<FNameProperty>(Property))
+        {
+            OutKind = EFieldKind::Name;
+        }
+        else if (CastField<FStrProperty>(Property))
+        {
+            OutKind = EFieldKind::String;
+        }
+        else if (CastField<FTextProperty>(Property))
+        {
+            OutKind = EFieldKind::Text;
+        }
+        else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            OutKind = GetStructKind(StructProperty->Struct);
+        }
+        else if (FLuaContainerProxy::IsContainer(Property))
+        {
+            OutKind = EFieldKind::Container;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    TUniquePtr<FStructPlan> BuildPlan(const UScriptStruct* Struct)
+    {
+        TUniquePtr<FStructPlan> Plan = MakeUnique<FStructPlan>();
+        Plan->Id = NextPlanId++;
+        Plan->Struct = Struct;
+        Plan->PropertyLink = Struct->PropertyLink;
+
+        for (TFieldIterator<FProperty> It(Struct); It; ++It)
+        {
+            // Static arrays and unsupported types (delegates, interfaces, ...) are left out of the table
+            EFieldKind Kind;
+            if (It->ArrayDim != 1 || !ClassifyProperty(*It, Kind))
+            {
+                continue;
+            }
+
+            const FStructPlan* Nested = Kind == EFieldKind::Struct ? &FindOrBuildPlan(CastFieldChecked<FStructProperty>(*It)->Struct) : nullptr;
+            Plan->Fields.Add({ *It, It->GetOffset_ForInternal(), Kind, Nested });
+            const FTCHARToUTF8 Name(*It->GetName());
+            Plan->FieldNames.Emplace(Name.Get(), Name.Length());
+        }
+
+        INC_DWORD_STAT(STAT_LuaStructPlansBuilt);
+        return Plan;
+    }
+
+    const FStructPlan& FindOrBuildPlan(const UScriptStruct* Struct)
+    {
+        if (const TUniquePtr<FStructPlan>* Existing = Plans.Find(Struct))
+        {
+            if ((*Existing)->Struct.Get() == Struct && (*Existing)->PropertyLink == Struct->PropertyLink)
+            {
+                return **Existing;
+            }
+
+            // Other plans may point at the stale one as a nested plan, start over (editor only, when structs
+            // are recompiled); the old plans are retired rather than freed, a caller up the stack may be reading
+            // a struct with one of them
+            for (TPair<const UScriptStruct*, TUniquePtr<FStructPlan>>& Pair : Plans)
+            {
+                RetiredPlans.Add(MoveTemp(Pair.Value));
+            }
+            Plans.Reset();
+        }
+
+        // Built before adding, nested plans may add to the map while building
+        TUniquePtr<FStructPlan> Plan = BuildPlan(Struct);
+        return *Plans.Add(Struct, MoveTemp(Plan));
+    }
+
+    const FStructPlan& FindPlan(const UScriptStruct* Struct)
+    {
+        FScopeLock Lock(&PlansLock);
+        return FindOrBuildPlan(Struct);
+    }
+
+    // Push the array of interned field name strings of a plan for this state, creating it on first use
+    void PushFieldNames(lua_State* L, const FStructPlan& Plan)
+    {
+        if (lua_rawgetp(L, LUA_REGISTRYINDEX, &StructFieldNamesKey) != LUA_TTABLE)
+        {
+            lua_pop(L, 1);
+            lua_newtable(L);
+            lua_pushvalue(L, -1);
+            lua_rawsetp(L, LUA_REGISTRYINDEX, &StructFieldNamesKey);
+        }
+
+        if (lua_rawgeti(L, -1, Plan.Id) != LUA_TTABLE)
+        {
+            lua_pop(L, 1);
+            lua_createtable(L, Plan.FieldNames.Num(), 0);
+            for (int32 Field = 0; Field < Plan.FieldNames.Num(); ++Field)
+            {
+                lua_pushlstring(L, Plan.FieldNames[Field].GetData(), Plan.FieldNames[Field].Num());
+                lua_rawseti(L, -2, Field + 1);
+            }
+            lua_pushvalue(L, -1);
+            lua_rawseti(L, -3, Plan.Id);
+        }
+
+        // Drop the registry table, leaving the names
+        lua_remove(L, -2);
+    }
+
+    void PushPlannedStruct(lua_State* L, const FStructPlan& Plan, const uint8* Data, int OutIndex);
+    bool ReadPlannedStruct(lua_State* L, int Index, const FStructPlan& Plan, uint8* Data);
+
+    // Push one field; OutIndex is an existing value to fill in place (nested tables), 0 if there is none
+    void PushField(lua_State* L, const FFieldPlan& Field, const void* ValuePtr, int OutIndex)
+    {
+        switch (Field.Kind)
+        {
+        case EFieldKind::Bool:
+            lua_pushboolean(L, static_cast<const FBoolProperty*>(Field.Property)->GetPropertyValue(ValuePtr));
+            break;
+        case EFieldKind::Integer:
+            lua_pushinteger(L, (lua_Integer)static_cast<const FNumericProperty*>(Field.Property)->GetSignedIntPropertyValue(ValuePtr));
+            break;
+        case EFieldKind::Float:
+            lua_pushnumber(L, *static_cast<const float*>(ValuePtr));
+            break;
+        case EFieldKind::Double:
+            lua_pushnumber(L, *static_cast<const double*>(ValuePtr));
+            break;
+        case EFieldKind::Enum:
+            lua_pushinteger(L, (lua_Integer)static_cast<const FEnumProperty*>(Field.Property)->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr));
+            break;
+        case EFieldKind::Object:
+            FLuaBinding::PushUObject(L, static_cast<const FObjectPropertyBase*>(Field.Property)->GetObjectPropertyValue(ValuePtr));
+            break;
+        case EFieldKind::Name:
+            FLuaStringBridge::PushName(L, *static_cast<const FName*>(ValuePtr));
+            break;
+        case EFieldKind::String:
+            FLuaStringBridge::PushString(L, *static_cast<const FString*>(ValuePtr));
+            break;
+        case EFieldKind::Text:
+            FLuaStringBridge::PushString(L, static_cast<const FText*>(ValuePtr)->ToString());
+            break;
+        case EFieldKind::Vector:
+            FLuaValueTypes::PushVector(L, *static_cast<const FVector*>(ValuePtr));
+            break;
+        case EFieldKind::Rotator:
+            FLuaValueTypes::PushRotator(L, *static_cast<const FRotator*>(ValuePtr));
+            break;
+        case EFieldKind::Quat:
+            FLuaValueTypes::PushQuat(L, *static_cast<const FQuat*>(ValuePtr));
+            break;
+        case EFieldKind::Transform:
+            FLuaValueTypes::PushTransform(L, *static_cast<const FTransform*>(ValuePtr));
+            break;
+        case EFieldKind::Struct:
+            PushPlannedStruct(L, *Field.Nested, static_cast<const uint8*>(ValuePtr), OutIndex);
+            break;
+        case EFieldKind::Container:
+            // Struct memory is usually transient, so containers are copied
+            FLuaContainerProxy::PushTable(L, Field.Property, ValuePtr);
+            break;
+        }
+    }
+
+    bool ReadField(lua_State* L, int Index, const FFieldPlan& Field, void* ValuePtr)
+    {
+        switch (Field.Kind)
+        {
+        case EFieldKind::Vector:
+            return FLuaValueTypes::GetVector(L, Index, *static_cast<FVector*>(ValuePtr));
+        case EFieldKind::Rotator:
+            return FLuaValueTypes::GetRotator(L, Index, *static_cast<FRotator*>(ValuePtr));
+        case EFieldKind::Quat:
+            return FLuaValueTypes::GetQuat(L, Index, *static_cast<FQuat*>(ValuePtr));
+        case EFieldKind::Transform:
+            return FLuaValueTypes::GetTransform(L, Index, *static_cast<FTransform*>(ValuePtr));
+        case EFieldKind::Struct:
+            return ReadPlannedStruct(L, Index, *Field.Nested, static_cast<uint8*>(ValuePtr));
+        case EFieldKind::Container:
+            return FLuaContainerProxy::ReadTable(L, Index, Field.Property, ValuePtr);
+        default:
+            return FLuaPropertyMarshal::ReadProperty(L, Index, Field.Property, ValuePtr);
+        }
+    }
+
+    void PushPlannedStruct(lua_State* L, const FStructPlan& Plan, const uint8* Data, int OutIndex)
+    {
+        luaL_checkstack(L, 4, "struct too deeply nested");
+
+        if (OutIndex != 0 && lua_istable(L, OutIndex))
+        {
+            lua_pushvalue(L, OutIndex);
+        }
+        else
+        {
+            lua_createtable(L, 0, Plan.Fields.Num());
+        }
+        const int TableIndex = lua_gettop(L);
+
+        PushFieldNames(L, Plan);
+        const int NamesIndex = TableIndex + 1;
+
+        for (int32 FieldIndex = 0; FieldIndex < Plan.Fields.Num(); ++FieldIndex)
+        {
+            const FFieldPlan& Field = Plan.Fields[FieldIndex];
+
+            // The interned name string carries its hash, so the set below does not hash anything
+            lua_rawgeti(L, NamesIndex, FieldIndex + 1);
+
+            // Nested structs refill the table already stored in the field
+            int NestedIndex = 0;
+            if (Field.Kind == EFieldKind::Struct)
+            {
+                lua_pushvalue(L, -1);
+                lua_rawget(L, TableIndex);
+                NestedIndex = lua_gettop(L);
+            }
+
+            PushField(L, Field, Data + Field.Offset, NestedIndex);
+            if (NestedIndex != 0)
+            {
+                lua_remove(L, NestedIndex);
+            }
+            lua_rawset(L, TableIndex);
+        }
+
+        // Pop the names, leaving the table
+        lua_pop(L, 1);
+    }
+
+    bool ReadPlannedStruct(lua_State* L, int Index, const FStructPlan& Plan, uint8* Data)
+    {
+        if (!lua_istable(L, Index))
+        {
+            return false;
+        }
+        Index = lua_absindex(L, Index);
+        luaL_checkstack(L, 4, "struct too deeply nested");
+
+        PushFieldNames(L, Plan);
+        for (int32 FieldIndex = 0; FieldIndex < Plan.Fields.Num(); ++FieldIndex)
+        {
+            const FFieldPlan& Field = Plan.Fields[FieldIndex];
+
+            lua_rawgeti(L, -1, FieldIndex + 1);
+            if (lua_rawget(L, Index) != LUA_TNIL)
+            {
+                ReadField(L, -1, Field, Data + Field.Offset);
+            }
+            lua_pop(L, 1);
+        }
+
+        // Pop the names
+        lua_pop(L, 1);
+        return true;
+    }
+}
+
+bool FLuaPropertyMarshal::PushProperty(lua_State* L, const FProperty* Property, const void* ValuePtr)
+{
+    if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+    {
+        lua_pushboolean(L, BoolProperty->GetPropertyValue(ValuePtr));
+        return true;
+    }
+
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+    {
+        lua_pushinteger(L, (lua_Integer)EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr));
+        return true;
+    }
+
+    if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+    {
+        if (NumericProperty->IsFloatingPoint())
+        {
+            lua_pushnumber(L, NumericProperty->GetFloatingPointPropertyValue(ValuePtr));
+        }
+        else
+        {
+            lua_pushinteger(L, (lua_Integer)NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+        }
+        return true;
+    }
+
+    if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+    {
+        FLuaBinding::PushUObject(L, ObjectProperty->GetObjectPropertyValue(ValuePtr));
+        return true;
+    }
+
+    if (CastField<FNameProperty>(Property))
+    {
+        FLuaStringBridge::PushName(L, *static_cast<const FName*>(ValuePtr));
+        return true;
+    }
+
+    if (CastField<FStrProperty>(Property))
+    {
+        FLuaStringBridge::PushString(L, *static_cast<const FString*>(ValuePtr));
+        return true;
+    }
+
+    if (CastField<FTextProperty>(Property))
+    {
+        FLuaStringBridge::PushString(L, static_cast<const FText*>(ValuePtr)->ToString());
+        return true;
+    }
+
+    if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+    {
+        const UScriptStruct* Struct = StructProperty->Struct;
+        if (Struct->IsChildOf(TBaseStructure<FVector>::Get()))
+        {
+            FLuaValueTypes::PushVector(L, *static_cast<const FVector*>(ValuePtr));
+            return true;
+        }
+        if (Struct->IsChildOf(TBaseStructure<FRotator>::Get()))
+        {
+            FLuaValueTypes::PushRotator(L, *static_cast<const FRotator*>(ValuePtr));
+            return true;
+        }
+        if (Struct->IsChildOf(TBaseStructure<FQuat>::Get()))
+        {
+            FLuaValueTypes::PushQuat(L, *static_cast<const FQuat*>(ValuePtr));
+            return true;
+        }
+        if (Struct->IsChildOf(TBaseStructure<FTransform>::Get()))
+        {
+            FLuaValueTypes::PushTransform(L, *static_cast<const FTransform*>(ValuePtr));
+            return true;
+        }
+
+        PushStruct(L, Struct, ValuePtr);
+        return true;
+    }
+
+    // The memory handed to us is usually transient (parameters), so containers are copied
+    if (FLuaContainerProxy::IsContainer(Property))
+    {
+        return FLuaContainerProxy::PushTable(L, Property, ValuePtr);
+    }
+
+    lua_pushnil(L);
+    return false;
+}
+
+bool FLuaPropertyMarshal::ReadProperty(lua_State* L, int Index, const FProperty* Property, void* ValuePtr)
+{
+    if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+    {
+        BoolProperty->SetPropertyValue(ValuePtr, lua_toboolean(L, Index) != 0);
+        return true;
+    }
+
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+    {
+        if (!lua_isinteger(L, Index))
+        {
+            return false;
+        }
+        EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(ValuePtr, (int64)lua_tointeger(L, Index));
+        return true;
+    }
+
+    if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+    {
+        if (lua_type(L, Index) != LUA_TNUMBER)
+        {
+            return false;
+        }
+        if (NumericProperty->IsFloatingPoint())
+        {
+            NumericProperty->SetFloatingPointPropertyValue(ValuePtr, lua_tonumber(L, Index));
+        }
+        else
+        {
+            // Numbers with a fractional part (or out of the integer range) are rejected rather than read as 0
+            int IsInteger = 0;
+            const lua_Integer Value = lua_tointegerx(L, Index, &IsInteger);
+            if (!IsInteger)
+            {
+                return false;
+            }
+            NumericProperty->SetIntPropertyValue(ValuePtr, (int64)Value);
+        }
+        return true;
+    }
+
+    if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+    {
+        // nil clears the reference, objects of the wrong class are rejected
+        UObject* Object = lua_isnil(L, Index) ? nullptr : FLuaBinding::GetUObject(L, Index);
+        if (!lua_isnil(L, Index) && (!Object || !Object->IsA(ObjectProperty->PropertyClass)))
+        {
+            return false;
+        }
+        ObjectProperty->SetObjectPropertyValue(ValuePtr, Object);
+        return true;
+    }
+
+    if (lua_type(L, Index) == LUA_TSTRING)
+    {
+        if (CastField<FNameProperty>(Property))
+        {
+            *static_cast<FName*>(ValuePtr) = FLuaStringBridge::ToName(L, Index);
+            return true;
+        }
+        if (CastField<FStrProperty>(Property))
+        {
+            *static_cast<FString*>(ValuePtr) = FLuaStringBridge::ToTCHAR(L, Index);
+            return true;
+        }
+        if (CastField<FTextProperty>(Property))
+        {
+            *static_cast<FText*>(ValuePtr) = FText::FromString(FLuaStringBridge::ToTCHAR(L, Index));
+            return true;
+        }
+    }
+
+    if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+    {
+        const UScriptStruct* Struct = StructProperty->Struct;
+        if (Struct->IsChildOf(TBaseStructure<FVector>::Get()))
+        {
+            return FLuaValueTypes::GetVector(L, Index, *static_cast<FVector*>(ValuePtr));
+        }
+        if (Struct->IsChildOf(TBaseStructure<FRotator>::Get()))
+        {
+            return FLuaValueTypes::GetRotator(L, Index, *static_cast<FRotator*>(ValuePtr));
+        }
+        if (Struct->IsChildOf(TBaseStructure<FQuat>::Get()))
+        {
+            return FLuaValueTypes::GetQuat(L, Index, *static_cast<FQuat*>(ValuePtr));
+        }
+        if (Struct->IsChildOf(TBaseStructure<FTransform>::Get()))
+        {
+            return FLuaValueTypes::GetTransform(L, Index, *static_cast<FTransform*>(ValuePtr));
+        }
+        return ReadStruct(L, Index, Struct, ValuePtr);
+    }
+
+    if (FLuaContainerProxy::IsContainer(Property))
+    {
+        return FLuaContainerProxy::ReadTable(L, Index, Property, ValuePtr);
+    }
+
+    return false;
+}
+
+int FLuaPropertyMarshal::PushParameters(lua_State* L, const UFunction* Function, const void* Params)
+{
+    luaL_checkstack(L, Function->NumParms, "too many parameters");
+
+    int NumPushed = 0;
+    for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+    {
+        // Pure outputs have no value yet, const references are inputs
+        if (It->HasAnyPropertyFlags(CPF_ReturnParm) || (It->HasAnyPropertyFlags(CPF_OutParm) && !It->HasAnyPropertyFlags(CPF_ReferenceParm)))
+        {
+            continue;
+        }
+
+        PushProperty(L, *It, It->ContainerPtrToValuePtr<void>(Params));
+        ++NumPushed;
+    }
+    return NumPushed;
+}
+
+void FLuaPropertyMarshal::PushStruct(lua_State* L, const UScriptStruct* Struct, const void* Data, int OutIndex)
+{
+    check(IsInGameThread() || FLuaCommandBuffer::IsRecording());
+    LuaPropertyMarshal::PushPlannedStruct(L, LuaPropertyMarshal::FindPlan(Struct), static_cast<const uint8*>(Data), OutIndex != 0 ? lua_absindex(L, OutIndex) : 0);
+}
+
+bool FLuaPropertyMarshal::ReadStruct(lua_State* L, int Index, const UScriptStruct* Struct, void* Data)
+{
+    check(IsInGameThread() || FLuaCommandBuffer::IsRecording());
+    return LuaPropertyMarshal::ReadPlannedStruct(L, Index, LuaPropertyMarshal::FindPlan(Struct), static_cast<uint8*>(Data));
+}
\ No newline at end of file
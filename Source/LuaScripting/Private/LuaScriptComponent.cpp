@@ -1,6 +1,10 @@
 #include "LuaScriptComponent.h"
 #include "LuaStateManager.h"
 #include "LuaBinding.h"
+#include "LuaStateContext.h"
+#include "LuaStringBridge.h"
+#include "LuaTickSubsystem.h"
+#include "Engine/World.h"
 
 // Include Lua headers
 extern "C" {
@@ -11,13 +15,22 @@ extern "C" {
 
 ULuaScriptComponent::ULuaScriptComponent()
 {
+    // The component's own tick is only enabled when it does not use the batched tick
     PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+
+    // Active unless deactivated (e.g. by the actor pool), the batched tick skips inactive components
+    bAutoActivate = true;
     bAutoRun = true;
     bCallTickFunction = true;
+    bUseBatchedTick = true;
+    bTickInParallel = false;
     bScriptInitialized = false;
     ComponentLuaState = nullptr;
     GCInterval = 30;  // Run GC every 30 frames
     GCCounter = 0;
+    bTickBatched = false;
+    bBatchedTickEnabled = true;
 }
 
 void ULuaScriptComponent::BeginPlay()
@@ -46,6 +59,12 @@ void ULuaScriptComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+    // Ticked by the subsystem, the tick function can still be enabled by code that doesn't know about it
+    if (bTickBatched)
+    {
+        return;
+    }
+
     if (bScriptInitialized && bCallTickFunction && ComponentLuaState)
     {
         // Call the tick function if it exists
@@ -77,6 +96,29 @@ void ULuaScriptComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
     }
 }
 
+void ULuaScriptComponent::SetComponentTickEnabled(bool bEnabled)
+{
+    if (bTickBatched)
+    {
+        bBatchedTickEnabled = bEnabled;
+        return;
+    }
+
+    Super::SetComponentTickEnabled(bEnabled);
+}
+
+bool ULuaScriptComponent::ShouldTickBatched() const
+{
+    if (!bCallTickFunction || !bBatchedTickEnabled || !IsActive())
+    {
+        return false;
+    }
+
+    // Only actors that tick at all can have their tick disabled
+    const AActor* Owner = GetOwner();
+    return !Owner || !Owner->PrimaryActorTick.bCanEverTick || Owner->IsActorTickEnabled();
+}
+
 bool ULuaScriptComponent::ExecuteScript(FString & ErrorMessage)
 {
     // Clean up any existing environment
@@ -161,6 +203,9 @@ bool ULuaScriptComponent::LoadAndExecuteScript(const FString & ContentToExecute,
     }
 
     bScriptInitialized = true;
+
+    // Picks up the tick function the script defines, also after a hot reload
+    RegisterTick();
     return true;
 }
 
@@ -173,7 +218,7 @@ bool ULuaScriptComponent::CallFunction(const FString & FunctionName, FString & E
     }
 
     // Get the function from the global table
-    lua_getglobal(ComponentLuaState, TCHAR_TO_UTF8(*FunctionName));
+    lua_getglobal(ComponentLuaState, FLuaStringBridge::ToUTF8(FunctionName));
     if (!lua_isfunction(ComponentLuaState, -1))
     {
         lua_pop(ComponentLuaState, 1);
@@ -381,6 +426,7 @@ bool ULuaScriptComponent::InitializeLuaEnvironment(FString & ErrorMessage)
         FLuaBinding::RegisterMathFunctions(ComponentLuaState);
         FLuaBinding::RegisterLogFunctions(ComponentLuaState);
         FLuaBinding::RegisterActorFunctions(ComponentLuaState);
+        FLuaBinding::RegisterWorldFunctions(ComponentLuaState);
     }
     else
     {
@@ -388,6 +434,12 @@ bool ULuaScriptComponent::InitializeLuaEnvironment(FString & ErrorMessage)
         lua_pop(ComponentLuaState, 1);
     }
 
+    // Bind the state's native context to this component, bindings resolve their world and owner through it
+    if (FLuaStateContext* Context = FLuaStateContext::Get(ComponentLuaState))
+    {
+        Context->Bind(this);
+    }
+
     // Add the component's owner (actor) as a global
     if (GetOwner())
     {
@@ -407,10 +459,36 @@ void ULuaScriptComponent::CleanupLuaEnvironment()
 {
     if (ComponentLuaState)
     {
+        // The batched tick holds a reference into the state
+        UWorld* World = GetWorld();
+        if (ULuaTickSubsystem* TickSubsystem = World ? World->GetSubsystem<ULuaTickSubsystem>() : nullptr)
+        {
+            TickSubsystem->Unregister(this);
+        }
+        bTickBatched = false;
+
         // Release the state back to the pool
         FLuaStateManager::Get().ReleaseState(ComponentLuaState);
         ComponentLuaState = nullptr;
     }
 
     bScriptInitialized = false;
+}
+
+void ULuaScriptComponent::RegisterTick()
+{
+    UWorld* World = GetWorld();
+    ULuaTickSubsystem* TickSubsystem = (bUseBatchedTick && World) ? World->GetSubsystem<ULuaTickSubsystem>() : nullptr;
+    if (TickSubsystem)
+    {
+        // Scripts without a tick function are not ticked at all
+        Super::SetComponentTickEnabled(false);
+        TickSubsystem->Register(this, ComponentLuaState);
+        bTickBatched = true;
+    }
+    else
+    {
+        // Opted out, or a world type without batched ticking
+        Super::SetComponentTickEnabled(true);
+    }
 }
\ No newline at end of file
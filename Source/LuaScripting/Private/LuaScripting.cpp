@@ -1,5 +1,8 @@
 #include "LuaScripting.h"
 #include "LuaStateManager.h"
+#include "LuaLogSink.h"
+#include "LuaClassCache.h"
+#include "LuaSpawnScheduler.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
 
@@ -28,6 +31,15 @@ void FLuaScripting::StartupModule()
     {
         // Initialize the Lua state manager
         FLuaStateManager::Get().Initialize();
+
+        // Start flushing buffered Lua log messages once per frame
+        FLuaLogSink::Get().Startup();
+
+        // Drop cached class lookups on hot reload
+        FLuaClassCache::Get().Startup();
+
+        // Process budgeted UE.Actor.SpawnMany batches once per frame
+        FLuaSpawnScheduler::Get().Startup();
         UE_LOG(LogTemp, Log, TEXT("LuaScripting plugin loaded successfully"));
     }
     else
@@ -44,6 +56,15 @@ void FLuaScripting::ShutdownModule()
     // Clean up Lua state
     FLuaStateManager::Get().Shutdown();
 
+    // Drop pending spawn batches, their states are gone
+    FLuaSpawnScheduler::Get().Shutdown();
+
+    // Emit any log messages still buffered
+    FLuaLogSink::Get().Shutdown();
+
+    // Release cached and preloaded classes
+    FLuaClassCache::Get().Shutdown();
+
     // Free the dll handle
     FPlatformProcess::FreeDllHandle(LuaLibraryHandle);
     LuaLibraryHandle = nullptr;
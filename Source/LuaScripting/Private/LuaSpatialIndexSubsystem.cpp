@@ -0,0 +1,436 @@
+#include "LuaSpatialIndexSubsystem.h"
+#include "LuaStateManager.h"
+#include "LuaActorRegistrySubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarLuaSpatialCellSize(
+    TEXT("lua.Spatial.CellSize"),
+    1000.0f,
+    TEXT("Edge length of the grid cells used by the Lua spatial queries, read when a world starts"));
+
+DECLARE_CYCLE_STAT(TEXT("Spatial query"), STAT_LuaSpatialQuery, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("Spatial update"), STAT_LuaSpatialUpdate, STATGROUP_LuaScripting);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spatially tracked actors"), STAT_LuaSpatialTracked, STATGROUP_LuaScripting);
+
+void ULuaSpatialIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    CellSize = FMath::Max((double)CVarLuaSpatialCellSize.GetValueOnGameThread(), 1.0);
+
+    UWorld* World = GetWorld();
+    ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ULuaSpatialIndexSubsystem::OnActorSpawned));
+    ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ULuaSpatialIndexSubsystem::OnActorDestroyed));
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ULuaSpatialIndexSubsystem::OnLevelRemovedFromWorld);
+}
+
+void ULuaSpatialIndexSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+    for (const FEntry& Entry : Entries)
+    {
+        if (USceneComponent* Root = Entry.Root.Get())
+        {
+            Root->TransformUpdated.Remove(Entry.TransformHandle);
+        }
+    }
+
+    DEC_DWORD_STAT_BY(STAT_LuaSpatialTracked, EntryIds.Num());
+
+    Entries.Empty();
+    EntryIds.Empty();
+    Cells.Empty();
+    TrackedClasses.Empty();
+    TrackedTags.Empty();
+
+    Super::Deinitialize();
+}
+
+bool ULuaSpatialIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 ULuaSpatialIndexSubsystem::TrackClass(UClass* Class)
+{
+    if (!Class || !Class->IsChildOf(AActor::StaticClass()))
+    {
+        return 0;
+    }
+
+    TrackedClasses.Add(Class);
+
+    // Pick up the actors that already exist through the actor registry
+    TArray<AActor*> Actors;
+    if (ULuaActorRegistrySubsystem* Registry = GetWorld()->GetSubsystem<ULuaActorRegistrySubsystem>())
+    {
+        Registry->FindActorsOfClass(Class, true, Actors);
+    }
+
+    int32 NumAdded = 0;
+    for (AActor* Actor : Actors)
+    {
+        if (!EntryIds.Contains(Actor) && TrackActor(Actor))
+        {
+            ++NumAdded;
+        }
+    }
+    return NumAdded;
+}
+
+int32 ULuaSpatialIndexSubsystem::TrackTag(FName Tag)
+{
+    if (Tag.IsNone())
+    {
+        return 0;
+    }
+
+    TrackedTags.Add(Tag);
+
+    // One-off scan when the tag is registered
+    int32 NumAdded = 0;
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        if (It->Tags.Contains(Tag) && !EntryIds.Contains(*It) && TrackActor(*It))
+        {
+            ++NumAdded;
+        }
+    }
+    return NumAdded;
+}
+
+bool ULuaSpatialIndexSubsystem::TrackActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || Actor->GetWorld() != GetWorld())
+    {
+        return false;
+    }
+
+    USceneComponent* Root = Actor->GetRootComponent();
+    if (!Root)
+    {
+        return false;
+    }
+
+    if (EntryIds.Contains(Actor))
+    {
+        return true;
+    }
+
+    const int32 EntryId = Entries.Add(FEntry());
+    FEntry& Entry = Entries[EntryId];
+    Entry.Key = Actor;
+    Entry.Actor = Actor;
+    Entry.Root = Root;
+    Entry.Location = Root->GetComponentLocation();
+    Entry.Cell = ToCell(Entry.Location);
+    Entry.TransformHandle = Root->TransformUpdated.AddUObject(this, &ULuaSpatialIndexSubsystem::OnRootTransformUpdated, EntryId);
+
+    EntryIds.Add(Actor, EntryId);
+    AddToCell(EntryId);
+
+    INC_DWORD_STAT(STAT_LuaSpatialTracked);
+    return true;
+}
+
+void ULuaSpatialIndexSubsystem::UntrackActor(AActor* Actor)
+{
+    if (const int32* EntryId = EntryIds.Find(Actor))
+    {
+        RemoveEntry(*EntryId);
+    }
+}
+
+void ULuaSpatialIndexSubsystem::RemoveEntry(int32 EntryId)
+{
+    const FEntry& Entry = Entries[EntryId];
+    if (USceneComponent* Root = Entry.Root.Get())
+    {
+        Root->TransformUpdated.Remove(Entry.TransformHandle);
+    }
+    EntryIds.Remove(Entry.Key);
+
+    RemoveFromCell(EntryId);
+    Entries.RemoveAt(EntryId);
+
+    DEC_DWORD_STAT(STAT_LuaSpatialTracked);
+}
+
+FIntVector ULuaSpatialIndexSubsystem::ToCell(const FVector& Location) const
+{
+    // Clamped before converting, huge, infinite or NaN coordinates (unbounded query boxes) don't fit an int32
+    auto ToCoord = [this](double Value) { return FMath::FloorToInt32(FMath::Clamp(Value / CellSize, -1073741824.0, 1073741824.0)); };
+    return FIntVector(ToCoord(Location.X), ToCoord(Location.Y), ToCoord(Location.Z));
+}
+
+void ULuaSpatialIndexSubsystem::AddToCell(int32 EntryId)
+{
+    FEntry& Entry = Entries[EntryId];
+    TArray<int32>& Cell = Cells.FindOrAdd(Entry.Cell);
+    Entry.SlotInCell = Cell.Add(EntryId);
+
+    if (Cells.Num() == 1 && Cell.Num() == 1)
+    {
+        MinCell = MaxCell = Entry.Cell;
+    }
+    else
+    {
+        MinCell = FIntVector(FMath::Min(MinCell.X, Entry.Cell.X), FMath::Min(MinCell.Y, Entry.Cell.Y), FMath::Min(MinCell.Z, Entry.Cell.Z));
+        MaxCell = FIntVector(FMath::Max(MaxCell.X, Entry.Cell.X), FMath::Max(MaxCell.Y, Entry.Cell.Y), FMath::Max(MaxCell.Z, Entry.Cell.Z));
+    }
+}
+
+void ULuaSpatialIndexSubsystem::RemoveFromCell(int32 EntryId)
+{
+    FEntry& Entry = Entries[EntryId];
+    TArray<int32>* Cell = Cells.Find(Entry.Cell);
+    if (!Cell)
+    {
+        return;
+    }
+
+    // Swap-remove and fix up the slot of the entry that moved into the hole
+    Cell->RemoveAtSwap(Entry.SlotInCell, 1, EAllowShrinking::No);
+    if (Cell->IsValidIndex(Entry.SlotInCell))
+    {
+        Entries[(*Cell)[Entry.SlotInCell]].SlotInCell = Entry.SlotInCell;
+    }
+    Entry.SlotInCell = INDEX_NONE;
+
+    if (Cell->Num() == 0)
+    {
+        Cells.Remove(Entry.Cell);
+    }
+}
+
+template<typename FunctionType>
+void ULuaSpatialIndexSubsystem::ForEachInBox(const FBox& Box, FunctionType&& Function) const
+{
+    if (Cells.Num() == 0)
+    {
+        return;
+    }
+
+    // Cells outside the occupied range are empty, limiting the box to it keeps the loops below short
+    const FIntVector BoxFirst = ToCell(Box.Min);
+    const FIntVector BoxLast = ToCell(Box.Max);
+    const FIntVector First(FMath::Max(BoxFirst.X, MinCell.X), FMath::Max(BoxFirst.Y, MinCell.Y), FMath::Max(BoxFirst.Z, MinCell.Z));
+    const FIntVector Last(FMath::Min(BoxLast.X, MaxCell.X), FMath::Min(BoxLast.Y, MaxCell.Y), FMath::Min(BoxLast.Z, MaxCell.Z));
+    if (First.X > Last.X || First.Y > Last.Y || First.Z > Last.Z)
+    {
+        return;
+    }
+
+    auto VisitCell = [this, &Box, &Function](const TArray<int32>& Cell)
+    {
+        for (int32 EntryId : Cell)
+        {
+            const FEntry& Entry = Entries[EntryId];
+            if (Box.IsInsideOrOn(Entry.Location))
+            {
+                Function(EntryId, Entry);
+            }
+        }
+    };
+
+    // Large boxes visit the occupied cells rather than every cell they span
+    // In double, the product of three spans can exceed an int64
+    const double NumSpanned = ((double)Last.X - First.X + 1.0) * ((double)Last.Y - First.Y + 1.0) * ((double)Last.Z - First.Z + 1.0);
+    if (NumSpanned > Cells.Num())
+    {
+        for (const TPair<FIntVector, TArray<int32>>& Pair : Cells)
+        {
+            const FIntVector& Coord = Pair.Key;
+            if (Coord.X >= First.X && Coord.X <= Last.X && Coord.Y >= First.Y && Coord.Y <= Last.Y && Coord.Z >= First.Z && Coord.Z <= Last.Z)
+            {
+                VisitCell(Pair.Value);
+            }
+        }
+        return;
+    }
+
+    for (int32 Z = First.Z; Z <= Last.Z; ++Z)
+    {
+        for (int32 Y = First.Y; Y <= Last.Y; ++Y)
+        {
+            for (int32 X = First.X; X <= Last.X; ++X)
+            {
+                if (const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z)))
+                {
+                    VisitCell(*Cell);
+                }
+            }
+        }
+    }
+}
+
+void ULuaSpatialIndexSubsystem::QueryRadius(const FVector& Center, double Radius, TArray<AActor*>& OutActors) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaSpatialQuery);
+
+    const double RadiusSquared = Radius * Radius;
+    ForEachInBox(FBox::BuildAABB(Center, FVector(Radius)), [&](int32 EntryId, const FEntry& Entry)
+    {
+        AActor* Actor = Entry.Actor.Get();
+        if (FVector::DistSquared(Entry.Location, Center) <= RadiusSquared && IsValid(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    });
+}
+
+void ULuaSpatialIndexSubsystem::QueryBox(const FBox& Box, TArray<AActor*>& OutActors) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaSpatialQuery);
+
+    ForEachInBox(Box, [&](int32 EntryId, const FEntry& Entry)
+    {
+        AActor* Actor = Entry.Actor.Get();
+        if (IsValid(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    });
+}
+
+void ULuaSpatialIndexSubsystem::QueryNearest(const FVector& Center, int32 Count, double MaxRadius, TArray<AActor*>& OutActors) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaSpatialQuery);
+
+    if (Count <= 0 || EntryIds.Num() == 0)
+    {
+        return;
+    }
+
+    // Largest distance at which anything can be found, from the extent of the occupied cells
+    const FBox Occupied(FVector(MinCell) * CellSize, FVector(MaxCell + FIntVector(1)) * CellSize);
+    const double SearchLimit = FMath::Min(MaxRadius, FMath::Sqrt(Occupied.ComputeSquaredDistanceToPoint(Center)) + Occupied.GetSize().Size());
+
+    struct FCandidate
+    {
+        double DistanceSquared;
+        AActor* Actor;
+    };
+    TArray<FCandidate, TInlineAllocator<64>> Candidates;
+
+    // Grow the search sphere until it holds enough actors; everything closer than its radius has then been seen
+    double Radius = FMath::Min(CellSize, SearchLimit);
+    for (;;)
+    {
+        Candidates.Reset();
+        const double RadiusSquared = Radius * Radius;
+        ForEachInBox(FBox::BuildAABB(Center, FVector(Radius)), [&](int32 EntryId, const FEntry& Entry)
+        {
+            const double DistanceSquared = FVector::DistSquared(Entry.Location, Center);
+            AActor* Actor = Entry.Actor.Get();
+            if (DistanceSquared <= RadiusSquared && IsValid(Actor))
+            {
+                Candidates.Add({ DistanceSquared, Actor });
+            }
+        });
+
+        if (Candidates.Num() >= Count || Radius >= SearchLimit)
+        {
+            break;
+        }
+        Radius = FMath::Min(Radius * 2.0, SearchLimit);
+    }
+
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+
+    const int32 NumResults = FMath::Min(Count, Candidates.Num());
+    for (int32 Index = 0; Index < NumResults; ++Index)
+    {
+        OutActors.Add(Candidates[Index].Actor);
+    }
+}
+
+bool ULuaSpatialIndexSubsystem::ShouldTrack(const AActor* Actor) const
+{
+    for (const TObjectKey<UClass>& TrackedClass : TrackedClasses)
+    {
+        UClass* Class = TrackedClass.ResolveObjectPtr();
+        if (Class && Actor->IsA(Class))
+        {
+            return true;
+        }
+    }
+
+    for (const FName& Tag : Actor->Tags)
+    {
+        if (TrackedTags.Contains(Tag))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ULuaSpatialIndexSubsystem::OnRootTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 EntryId)
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaSpatialUpdate);
+
+    if (!Entries.IsValidIndex(EntryId) || Entries[EntryId].Root.Get() != Component)
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries[EntryId];
+    Entry.Location = Component->GetComponentLocation();
+
+    // Only re-bucket when the actor crossed into another cell
+    const FIntVector NewCell = ToCell(Entry.Location);
+    if (NewCell != Entry.Cell)
+    {
+        RemoveFromCell(EntryId);
+        Entries[EntryId].Cell = NewCell;
+        AddToCell(EntryId);
+    }
+}
+
+void ULuaSpatialIndexSubsystem::OnActorSpawned(AActor* Actor)
+{
+    if ((TrackedClasses.Num() > 0 || TrackedTags.Num() > 0) && ShouldTrack(Actor))
+    {
+        TrackActor(Actor);
+    }
+}
+
+void ULuaSpatialIndexSubsystem::OnActorDestroyed(AActor* Actor)
+{
+    UntrackActor(Actor);
+}
+
+void ULuaSpatialIndexSubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld)
+{
+    if (InWorld != GetWorld() || EntryIds.Num() == 0)
+    {
+        return;
+    }
+
+    // Streamed-out actors are not destroyed, drop them along with anything already gone
+    TArray<int32> ToRemove;
+    for (auto It = Entries.CreateConstIterator(); It; ++It)
+    {
+        const AActor* Actor = It->Actor.Get();
+        if (!Actor || !Level || Actor->GetLevel() == Level)
+        {
+            ToRemove.Add(It.GetIndex());
+        }
+    }
+
+    for (int32 EntryId : ToRemove)
+    {
+        RemoveEntry(EntryId);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "LuaSpawnScheduler.h"
+#include "LuaStateManager.h"
+#include "LuaStateContext.h"
+#include "LuaBinding.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_CYCLE_STAT(TEXT("SpawnMany"), STAT_LuaSpawnMany, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpawnMany actors"), STAT_LuaSpawnManyActors, STATGROUP_LuaScripting);
+
+// Actors deferred-spawned before they are finished together, and between budget checks
+static constexpr int32 SpawnChunkSize = 32;
+
+FLuaSpawnScheduler& FLuaSpawnScheduler::Get()
+{
+    static FLuaSpawnScheduler Instance;
+    return Instance;
+}
+
+void FLuaSpawnScheduler::Startup()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLuaSpawnScheduler::Tick));
+    }
+}
+
+void FLuaSpawnScheduler::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    // The states were closed by the state manager, which already cancelled their batches
+    Batches.Empty();
+}
+
+void FLuaSpawnScheduler::SpawnRange(UWorld* World, UClass* Class, TConstArrayView<FTransform> Transforms, TArray<AActor*>& OutActors)
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaSpawnMany);
+
+    // Construct every actor first, then run construction scripts and BeginPlay for all of them
+    const int32 FirstActor = OutActors.Num();
+    TArray<int32, TInlineAllocator<SpawnChunkSize>> TransformIndices;
+    for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+    {
+        AActor* Actor = World->SpawnActorDeferred<AActor>(Class, Transforms[Index], nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+        if (Actor)
+        {
+            OutActors.Add(Actor);
+            TransformIndices.Add(Index);
+        }
+    }
+
+    for (int32 Index = 0; Index < TransformIndices.Num(); ++Index)
+    {
+        AActor*& Actor = OutActors[FirstActor + Index];
+        Actor->FinishSpawning(Transforms[TransformIndices[Index]]);
+        if (!IsValid(Actor))
+        {
+            Actor = nullptr;
+        }
+    }
+
+    // Drop actors destroyed while finishing (e.g. by their own BeginPlay)
+    OutActors.RemoveAll([](const AActor* Actor) { return Actor == nullptr; });
+
+    INC_DWORD_STAT_BY(STAT_LuaSpawnManyActors, OutActors.Num() - FirstActor);
+}
+
+void FLuaSpawnScheduler::SpawnBatch(UWorld* World, UClass* Class, TConstArrayView<FTransform> Transforms, TArray<AActor*>& OutActors)
+{
+    if (World && Class)
+    {
+        OutActors.Reserve(OutActors.Num() + Transforms.Num());
+        SpawnRange(World, Class, Transforms, OutActors);
+    }
+}
+
+uint32 FLuaSpawnScheduler::Enqueue(lua_State* Thread, UWorld* World, UClass* Class, TArray<FTransform>&& Transforms, double BudgetSeconds)
+{
+    TUniquePtr<FBatch> Batch = MakeUnique<FBatch>();
+    Batch->Id = NextBatchId++;
+    Batch->World = World;
+    Batch->Class = Class;
+    Batch->Transforms = MoveTemp(Transforms);
+    Batch->BudgetSeconds = BudgetSeconds;
+    Batch->Actors.Reserve(Batch->Transforms.Num());
+
+    // Keep the coroutine alive while it waits
+    Batch->Thread = Thread;
+    lua_pushthread(Thread);
+    Batch->ThreadRef = luaL_ref(Thread, LUA_REGISTRYINDEX);
+
+    // Stop when the state goes back to the pool or is closed
+    Batch->Context = FLuaStateContext::Get(Thread);
+    if (Batch->Context)
+    {
+        Batch->ResetHandle = Batch->Context->OnReset.AddRaw(this, &FLuaSpawnScheduler::OnContextReset, Batch->Context);
+    }
+
+    const uint32 Id = Batch->Id;
+    Batches.Add(MoveTemp(Batch));
+    return Id;
+}
+
+bool FLuaSpawnScheduler::IsPending(uint32 BatchId) const
+{
+    return Batches.ContainsByPredicate([BatchId](const TUniquePtr<FBatch>& Batch) { return Batch->Id == BatchId; });
+}
+
+bool FLuaSpawnScheduler::SpawnChunk(FBatch& Batch)
+{
+    UWorld* World = Batch.World.Get();
+    UClass* Class = Batch.Class.Get();
+    if (!World || !Class || World->bIsTearingDown)
+    {
+        // Nothing more can be spawned, hand back what we have
+        Batch.NextIndex = Batch.Transforms.Num();
+        return false;
+    }
+
+    const int32 Count = FMath::Min(SpawnChunkSize, Batch.Transforms.Num() - Batch.NextIndex);
+
+    TArray<AActor*> Spawned;
+    Spawned.Reserve(Count);
+    SpawnRange(World, Class, TConstArrayView<FTransform>(Batch.Transforms).Slice(Batch.NextIndex, Count), Spawned);
+    Batch.NextIndex += Count;
+
+    for (AActor* Actor : Spawned)
+    {
+        Batch.Actors.Add(Actor);
+    }
+
+    return Batch.NextIndex < Batch.Transforms.Num();
+}
+
+void FLuaSpawnScheduler::Complete(FBatch& Batch)
+{
+    lua_State* Thread = Batch.Thread;
+
+    if (Batch.Context)
+    {
+        Batch.Context->OnReset.Remove(Batch.ResetHandle);
+    }
+
+    // The coroutine may have been finished by the script in the meantime
+    if (lua_status(Thread) == LUA_YIELD)
+    {
+        lua_createtable(Thread, Batch.Actors.Num(), 0);
+        int32 NumActors = 0;
+        for (const TWeakObjectPtr<AActor>& WeakActor : Batch.Actors)
+        {
+            if (AActor* Actor = WeakActor.Get())
+            {
+                FLuaBinding::PushUObject(Thread, Actor);
+                lua_rawseti(Thread, -2, ++NumActors);
+            }
+        }
+
+        int NumResults = 0;
+        const int Status = lua_resume(Thread, nullptr, 1, &NumResults);
+        if (Status == LUA_OK || Status == LUA_YIELD)
+        {
+            lua_pop(Thread, NumResults);
+        }
+        else
+        {
+            UE_LOG(LogLuaScripting, Error, TEXT("Lua error after SpawnMany: %s"), UTF8_TO_TCHAR(lua_tostring(Thread, -1)));
+            lua_pop(Thread, 1);
+        }
+    }
+
+    luaL_unref(Thread, LUA_REGISTRYINDEX, Batch.ThreadRef);
+}
+
+void FLuaSpawnScheduler::OnContextReset(FLuaStateContext* Context)
+{
+    for (const TUniquePtr<FBatch>& Batch : Batches)
+    {
+        if (Batch->Context == Context && !Batch->bCancelled)
+        {
+            // The state is still open, release the coroutine now
+            Batch->bCancelled = true;
+            luaL_unref(Batch->Thread, LUA_REGISTRYINDEX, Batch->ThreadRef);
+        }
+    }
+}
+
+bool FLuaSpawnScheduler::Tick(float DeltaTime)
+{
+    // Spawning runs BeginPlay, which may queue new batches (appended) or cancel existing ones (flagged)
+    for (int32 Index = 0; Index < Batches.Num(); ++Index)
+    {
+        FBatch* Batch = Batches[Index].Get();
+        const double EndTime = FPlatformTime::Seconds() + Batch->BudgetSeconds;
+        while (!Batch->bCancelled && SpawnChunk(*Batch) && FPlatformTime::Seconds() < EndTime)
+        {
+        }
+    }
+
+    // Finish batches one at a time; resuming a coroutine may queue new batches or reset the state of another batch
+    for (int32 Index = 0; Index < Batches.Num();)
+    {
+        if (!Batches[Index]->bCancelled && Batches[Index]->NextIndex < Batches[Index]->Transforms.Num())
+        {
+            ++Index;
+            continue;
+        }
+
+        TUniquePtr<FBatch> Batch = MoveTemp(Batches[Index]);
+        Batches.RemoveAt(Index);
+        if (!Batch->bCancelled)
+        {
+            Complete(*Batch);
+        }
+    }
+
+    // Keep ticking
+    return true;
+}
\ No newline at end of file
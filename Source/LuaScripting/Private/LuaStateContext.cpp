@@ -0,0 +1,54 @@
+#include "LuaStateContext.h"
+#include "LuaScriptComponent.h"
+#include "LuaCommandBuffer.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+static_assert(LUA_EXTRASPACE >= sizeof(FLuaStateContext*), "Lua extra space must hold a context pointer");
+
+FLuaStateContext* FLuaStateContext::Get(lua_State* L)
+{
+    return *static_cast<FLuaStateContext**>(lua_getextraspace(L));
+}
+
+void FLuaStateContext::Attach(lua_State* L, FLuaStateContext* Context)
+{
+    *static_cast<FLuaStateContext**>(lua_getextraspace(L)) = Context;
+    if (Context)
+    {
+        Context->MainThread = L;
+    }
+}
+
+void FLuaStateContext::Bind(ULuaScriptComponent* InComponent)
+{
+    Component = InComponent;
+    Owner = InComponent ? InComponent->GetOwner() : nullptr;
+    World = InComponent ? InComponent->GetWorld() : nullptr;
+}
+
+void FLuaStateContext::Reset()
+{
+    // Listeners are one-shot, they belong to whoever was using the state
+    OnReset.Broadcast();
+    OnReset.Clear();
+
+    if (MainThread)
+    {
+        Events.Reset(MainThread);
+
+        // Calls recorded by the previous script that were dropped instead of applied
+        FLuaCommandBuffer::DiscardPendingArguments(MainThread);
+    }
+
+    Component.Reset();
+    Owner.Reset();
+    World.Reset();
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "LuaBinding.h"
+#include "LuaStateContext.h"
 
 // Include Lua headers
 extern "C" {
@@ -11,6 +12,10 @@ extern "C" {
 #include "lauxlib.h"
 }
 
+DECLARE_CYCLE_STAT(TEXT("Event broadcast delivery"), STAT_LuaBroadcastDelivery, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Event broadcasts"), STAT_LuaBroadcasts, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Event broadcast deliveries"), STAT_LuaBroadcastDeliveries, STATGROUP_LuaScripting);
+
 // Static instance for singleton pattern
 static TSharedPtr<FLuaStateManager, ESPMode::ThreadSafe> LuaStateManagerInstance;
 
@@ -44,7 +49,7 @@ bool FLuaStateManager::Initialize()
     }
 
     // Create a new Lua state
-    MainLuaState = luaL_newstate();
+    MainLuaState = CreateState();
     if (!MainLuaState)
     {
         UE_LOG(LogLuaScripting, Error, TEXT("Failed to create Lua state"));
@@ -57,6 +62,9 @@ bool FLuaStateManager::Initialize()
     // Configure garbage collection
     ConfigureGarbageCollection(MainLuaState);
 
+    // Deliver cross-state events once per frame
+    BroadcastTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLuaStateManager::TickBroadcasts));
+
     bIsInitialized = true;
     UE_LOG(LogLuaScripting, Log, TEXT("Lua state manager initialized successfully"));
     return true;
@@ -66,10 +74,18 @@ void FLuaStateManager::Shutdown()
 {
     FScopeLock Lock(&StateLock);
 
+    if (BroadcastTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(BroadcastTickerHandle);
+        BroadcastTickerHandle.Reset();
+    }
+    PendingBroadcasts.Empty();
+    PendingPayload.Reset();
+
     // Clean up the main state
     if (MainLuaState)
     {
-        lua_close(MainLuaState);
+        CloseState(MainLuaState);
         MainLuaState = nullptr;
     }
 
@@ -78,10 +94,11 @@ void FLuaStateManager::Shutdown()
     {
         if (State)
         {
-            lua_close(State);
+            CloseState(State);
         }
     }
     StatePool.Empty();
+    EventSubscribers.Empty();
 
     bIsInitialized = false;
     UE_LOG(LogLuaScripting, Log, TEXT("Lua state manager shut down"));
@@ -121,7 +138,7 @@ lua_State* FLuaStateManager::AcquireState(FString& ErrorMessage)
     }
 
     // Create a new state
-    lua_State* NewState = luaL_newstate();
+    lua_State* NewState = CreateState();
     if (!NewState)
     {
         ErrorMessage = TEXT("Failed to create new Lua state");
@@ -144,6 +161,12 @@ void FLuaStateManager::ReleaseState(lua_State* State)
 
     FScopeLock Lock(&StateLock);
 
+    // Detach the state from the component that was using it
+    if (FLuaStateContext* Context = FLuaStateContext::Get(State))
+    {
+        Context->Reset();
+    }
+
     // Check if we should keep it in the pool
     if (StatePool.Num() < MaxPoolSize)
     {
@@ -204,7 +227,7 @@ void FLuaStateManager::ReleaseState(lua_State* State)
             UE_LOG(LogLuaScripting, Warning, TEXT("Failed to reset Lua state: %s"), UTF8_TO_TCHAR(ErrorMsg));
             lua_pop(State, 1);
 
-            lua_close(State);
+            CloseState(State);
             return;
         }
 
@@ -217,8 +240,32 @@ void FLuaStateManager::ReleaseState(lua_State* State)
     else
     {
         // Just close it
-        lua_close(State);
+        CloseState(State);
+    }
+}
+
+lua_State* FLuaStateManager::CreateState()
+{
+    lua_State* State = luaL_newstate();
+    if (State)
+    {
+        // Give the state its native context, reachable through the extra space of every thread it creates
+        FLuaStateContext::Attach(State, new FLuaStateContext());
+    }
+    return State;
+}
+
+void FLuaStateManager::CloseState(lua_State* State)
+{
+    FLuaStateContext* Context = FLuaStateContext::Get(State);
+    if (Context)
+    {
+        // Let native work tied to the state clean up while the state is still alive
+        Context->Reset();
     }
+
+    lua_close(State);
+    delete Context;
 }
 
 void FLuaStateManager::ConfigureGarbageCollection(lua_State* State)
@@ -257,6 +304,7 @@ void FLuaStateManager::SetupLuaState(lua_State* State)
     FLuaBinding::RegisterMathFunctions(State);
     FLuaBinding::RegisterLogFunctions(State);
     FLuaBinding::RegisterActorFunctions(State);
+    FLuaBinding::RegisterWorldFunctions(State);
 }
 
 int FLuaStateManager::LuaErrorHandler(lua_State* State)
@@ -341,3 +389,111 @@ bool FLuaStateManager::HandleLuaError(lua_State* State, FString& ErrorMessage)
     UE_LOG(LogLuaScripting, Error, TEXT("Lua error: %s"), *ErrorMessage);
     return false;
 }
+
+bool FLuaStateManager::BroadcastEvent(lua_State* L, FName Event, int FirstArg, int NumArgs, const char*& OutError)
+{
+    check(IsInGameThread());
+
+    int32 PayloadOffset = 0;
+    if (!PendingPayload.Append(L, FirstArg, NumArgs, PayloadOffset, OutError))
+    {
+        return false;
+    }
+
+    PendingBroadcasts.Add({ Event, PayloadOffset });
+    INC_DWORD_STAT(STAT_LuaBroadcasts);
+    return true;
+}
+
+void FLuaStateManager::AddEventSubscriber(lua_State* L, FName Event)
+{
+    if (FLuaStateContext* Context = FLuaStateContext::Get(L))
+    {
+        EventSubscribers.FindOrAdd(Event).Add(Context->MainThread);
+    }
+}
+
+void FLuaStateManager::RemoveEventSubscriber(lua_State* L, FName Event)
+{
+    FLuaStateContext* Context = FLuaStateContext::Get(L);
+    TSet<lua_State*>* Subscribers = Context ? EventSubscribers.Find(Event) : nullptr;
+    if (Subscribers)
+    {
+        Subscribers->Remove(Context->MainThread);
+        if (Subscribers->Num() == 0)
+        {
+            EventSubscribers.Remove(Event);
+        }
+    }
+}
+
+bool FLuaStateManager::TickBroadcasts(float DeltaTime)
+{
+    if (PendingBroadcasts.Num() == 0)
+    {
+        return true;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LuaBroadcastDelivery);
+
+    // Events broadcast by the handlers below are delivered next frame
+    Swap(PendingBroadcasts, DeliveringBroadcasts);
+    Swap(PendingPayload, DeliveringPayload);
+
+    for (const FPendingBroadcast& Broadcast : DeliveringBroadcasts)
+    {
+        const TSet<lua_State*>* Subscribers = EventSubscribers.Find(Broadcast.Event);
+        if (!Subscribers)
+        {
+            continue;
+        }
+
+        DeliveryTargets.Reset();
+        for (lua_State* State : *Subscribers)
+        {
+            DeliveryTargets.Add(State);
+        }
+
+        for (lua_State* State : DeliveryTargets)
+        {
+            // Handlers may close states or remove handlers of other states while we deliver
+            Subscribers = EventSubscribers.Find(Broadcast.Event);
+            if (!Subscribers || !Subscribers->Contains(State))
+            {
+                continue;
+            }
+
+            // The values are only decoded for states that still listen
+            lua_pushcfunction(State, &FLuaStateManager::DeliverBroadcast);
+            lua_pushlightuserdata(State, const_cast<FPendingBroadcast*>(&Broadcast));
+            if (lua_pcall(State, 1, 0, 0) != LUA_OK)
+            {
+                UE_LOG(LogLuaScripting, Error, TEXT("Failed to deliver event '%s': %s"), *Broadcast.Event.ToString(), UTF8_TO_TCHAR(lua_tostring(State, -1)));
+                lua_pop(State, 1);
+            }
+            INC_DWORD_STAT(STAT_LuaBroadcastDeliveries);
+        }
+    }
+
+    DeliveringBroadcasts.Reset();
+    DeliveringPayload.Reset();
+
+    // Keep ticking
+    return true;
+}
+
+int FLuaStateManager::DeliverBroadcast(lua_State* State)
+{
+    const FPendingBroadcast* Broadcast = static_cast<const FPendingBroadcast*>(lua_touserdata(State, 1));
+    FLuaStateContext* Context = FLuaStateContext::Get(State);
+    lua_settop(State, 0);
+
+    const int NumValues = Get().DeliveringPayload.Push(State, Broadcast->PayloadOffset);
+    if (NumValues == INDEX_NONE)
+    {
+        return luaL_error(State, "not enough stack space for the event values");
+    }
+
+    Context->Events.Trigger(State, Broadcast->Event, 1, NumValues);
+    return 0;
+}
\ No newline at end of file
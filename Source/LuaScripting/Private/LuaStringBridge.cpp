@@ -0,0 +1,228 @@
+#include "LuaStringBridge.h"
+#include "LuaStateManager.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Name cache misses"), STAT_LuaNameCacheMisses, STATGROUP_LuaScripting);
+
+// Registry keys of the string -> FName and FName -> string cache tables, the addresses are what matters; not const, so
+// the compiler can't merge them into one constant
+static char NameCacheKey = 0;
+static char StringCacheKey = 0;
+
+namespace LuaStringBridge
+{
+    // Scratch buffers for conversions that cannot be cached; they only grow, so steady state use does not allocate
+    thread_local TArray<TCHAR> TCHARBuffer;
+    thread_local TArray<ANSICHAR> UTF8Buffer;
+
+    // Push the entry count of the cache table on top of the stack, counted under the key true so it can't collide with
+    // the string keys of the name cache or the integer keys of the string cache
+    void PushCacheCount(lua_State* L)
+    {
+        lua_pushboolean(L, 1);
+        lua_rawget(L, -2);
+    }
+
+    // Set the entry count of the cache table below the count on top of the stack, popping the count
+    void SetCacheCount(lua_State* L)
+    {
+        lua_pushboolean(L, 1);
+        lua_insert(L, -2);
+        lua_rawset(L, -3);
+    }
+
+    // Push a cache table of the state, creating it if needed
+    void PushCache(lua_State* L, const char* Key, bool bReset)
+    {
+        if (!bReset && lua_rawgetp(L, LUA_REGISTRYINDEX, Key) == LUA_TTABLE)
+        {
+            return;
+        }
+        if (!bReset)
+        {
+            lua_pop(L, 1);
+        }
+
+        lua_createtable(L, 0, 64);
+        lua_pushinteger(L, 0);
+        SetCacheCount(L);
+        lua_pushvalue(L, -1);
+        lua_rawsetp(L, LUA_REGISTRYINDEX, Key);
+    }
+
+    // Count a new entry in the cache table on top of the stack, replacing the table by an empty one when full
+    void ReserveCacheEntry(lua_State* L, const char* Key, int32 MaxEntries)
+    {
+        PushCacheCount(L);
+        const lua_Integer NumCached = lua_tointeger(L, -1);
+        lua_pop(L, 1);
+
+        // Start over once the cache grows too large, e.g. from scripts building names dynamically
+        if (NumCached >= MaxEntries)
+        {
+            lua_pop(L, 1);
+            PushCache(L, Key, true);
+        }
+
+        PushCacheCount(L);
+        const lua_Integer NewNumCached = lua_tointeger(L, -1) + 1;
+        lua_pop(L, 1);
+        lua_pushinteger(L, NewNumCached);
+        SetCacheCount(L);
+    }
+
+    // Look up the string at Index in the name cache; leaves the cache on the stack
+    bool FindCachedName(lua_State* L, int Index, FName& OutName)
+    {
+        PushCache(L, &NameCacheKey, false);
+
+        // The cached FName lives in a small userdata keyed by the string
+        lua_pushvalue(L, Index);
+        if (lua_rawget(L, -2) == LUA_TUSERDATA)
+        {
+            OutName = *static_cast<const FName*>(lua_touserdata(L, -1));
+            lua_pop(L, 1);
+            return true;
+        }
+        lua_pop(L, 1);
+        return false;
+    }
+
+    // Add a name to the name cache on top of the stack, then pop the cache
+    void CacheName(lua_State* L, int Index, FName Name, int32 MaxEntries)
+    {
+        ReserveCacheEntry(L, &NameCacheKey, MaxEntries);
+
+        lua_pushvalue(L, Index);
+        new (lua_newuserdatauv(L, sizeof(FName), 0)) FName(Name);
+        lua_rawset(L, -3);
+
+        // Pop the cache table
+        lua_pop(L, 1);
+    }
+
+    // Convert UTF-8 to TCHARs in the thread-local buffer
+    const TCHAR* ConvertToTCHAR(const char* String, int32 Length)
+    {
+        const int32 ConvertedLength = FPlatformString::ConvertedLength<TCHAR>((const UTF8CHAR*)String, Length);
+        TCHARBuffer.SetNumUninitialized(ConvertedLength + 1, EAllowShrinking::No);
+        FPlatformString::Convert(TCHARBuffer.GetData(), ConvertedLength, (const UTF8CHAR*)String, Length);
+        TCHARBuffer[ConvertedLength] = TEXT('\0');
+        return TCHARBuffer.GetData();
+    }
+}
+
+FName FLuaStringBridge::ToName(lua_State* L, int Index)
+{
+    using namespace LuaStringBridge;
+
+    size_t Length = 0;
+    const char* String = luaL_checklstring(L, Index, &Length);
+    Index = lua_absindex(L, Index);
+
+    FName Name;
+    if (FindCachedName(L, Index, Name))
+    {
+        lua_pop(L, 1);
+        return Name;
+    }
+
+    INC_DWORD_STAT(STAT_LuaNameCacheMisses);
+    Name = FName(ConvertToTCHAR(String, (int32)Length));
+
+    CacheName(L, Index, Name, MaxCachedNames);
+    return Name;
+}
+
+FName FLuaStringBridge::FindName(lua_State* L, int Index)
+{
+    using namespace LuaStringBridge;
+
+    if (lua_type(L, Index) != LUA_TSTRING)
+    {
+        return NAME_None;
+    }
+
+    size_t Length = 0;
+    const char* String = lua_tolstring(L, Index, &Length);
+    Index = lua_absindex(L, Index);
+
+    // Anything in the cache exists, ToName and FindName share it
+    FName Name;
+    if (FindCachedName(L, Index, Name))
+    {
+        lua_pop(L, 1);
+        return Name;
+    }
+
+    INC_DWORD_STAT(STAT_LuaNameCacheMisses);
+    Name = FName(ConvertToTCHAR(String, (int32)Length), FNAME_Find);
+
+    // Misses are not cached, unknown strings could otherwise flood the cache
+    if (Name.IsNone())
+    {
+        lua_pop(L, 1);
+        return NAME_None;
+    }
+
+    CacheName(L, Index, Name, MaxCachedNames);
+    return Name;
+}
+
+void FLuaStringBridge::PushName(lua_State* L, FName Name)
+{
+    using namespace LuaStringBridge;
+
+    // Display index and number identify the name's text; NAME_None is key 0, which the entry count doesn't use
+    const lua_Integer Key = (lua_Integer)(((uint64)Name.GetDisplayIndex().ToUnstableInt() << 32) | (uint32)Name.GetNumber());
+
+    PushCache(L, &StringCacheKey, false);
+    if (lua_rawgeti(L, -1, Key) == LUA_TSTRING)
+    {
+        // Replace the cache table by the string
+        lua_remove(L, -2);
+        return;
+    }
+    lua_pop(L, 1);
+
+    INC_DWORD_STAT(STAT_LuaNameCacheMisses);
+    ReserveCacheEntry(L, &StringCacheKey, MaxCachedNames);
+
+    TStringBuilder<FName::StringBufferSize> NameString;
+    Name.AppendString(NameString);
+    PushString(L, NameString.ToView());
+
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, -3, Key);
+    lua_remove(L, -2);
+}
+
+void FLuaStringBridge::PushString(lua_State* L, FStringView String)
+{
+    const char* Converted = ToUTF8(String);
+    lua_pushlstring(L, Converted, LuaStringBridge::UTF8Buffer.Num() - 1);
+}
+
+const TCHAR* FLuaStringBridge::ToTCHAR(lua_State* L, int Index)
+{
+    size_t Length = 0;
+    const char* String = luaL_checklstring(L, Index, &Length);
+    return LuaStringBridge::ConvertToTCHAR(String, (int32)Length);
+}
+
+const char* FLuaStringBridge::ToUTF8(FStringView String)
+{
+    using namespace LuaStringBridge;
+
+    const int32 ConvertedLength = FPlatformString::ConvertedLength<UTF8CHAR>(String.GetData(), String.Len());
+    UTF8Buffer.SetNumUninitialized(ConvertedLength + 1, EAllowShrinking::No);
+    FPlatformString::Convert((UTF8CHAR*)UTF8Buffer.GetData(), ConvertedLength, String.GetData(), String.Len());
+    UTF8Buffer[ConvertedLength] = '\0';
+    return UTF8Buffer.GetData();
+}
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include "LuaTickSubsystem.h"
+#include "LuaScriptComponent.h"
+#include "LuaStateManager.h"
+#include "LuaCommandBuffer.h"
+#include "LuaActorRegistrySubsystem.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+static TAutoConsoleVariable<float> CVarLuaTickBudgetMs(
+    TEXT("lua.Tick.BudgetMs"),
+    0.0f,
+    TEXT("Time in milliseconds the batched Lua ticks of a frame may take before scripts below their first tick LOD level are deferred to a later frame, 0 for no budget"));
+
+static TAutoConsoleVariable<bool> CVarLuaTickParallel(
+    TEXT("lua.Tick.Parallel"),
+    true,
+    TEXT("Tick the Lua scripts of components with Tick In Parallel on worker threads; when off they tick on the game thread like the others"));
+
+static TAutoConsoleVariable<int32> CVarLuaTickParallelMaxTasks(
+    TEXT("lua.Tick.ParallelMaxTasks"),
+    0,
+    TEXT("Largest number of worker tasks the parallel Lua tick is split into, which bounds the cores it uses; 0 for one task per script"));
+
+DECLARE_CYCLE_STAT(TEXT("Batched script tick"), STAT_LuaBatchedTick, STATGROUP_LuaScripting);
+DECLARE_CYCLE_STAT(TEXT("Parallel script tick"), STAT_LuaParallelTick, STATGROUP_LuaScripting);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ticked scripts"), STAT_LuaTickedScripts, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Script ticks run"), STAT_LuaTicksRun, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Script ticks deferred"), STAT_LuaTicksDeferred, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Script ticks run in parallel"), STAT_LuaTicksRunParallel, STATGROUP_LuaScripting);
+
+namespace LuaTickSubsystem
+{
+    void CallTickFunction(lua_State* L, int TickRef, float DeltaTime)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, TickRef);
+        lua_pushnumber(L, DeltaTime);
+        if (lua_pcall(L, 1, 0, 0) != LUA_OK)
+        {
+            UE_LOG(LogLuaScripting, Error, TEXT("Error in Lua tick function: %s"), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+            lua_pop(L, 1);
+        }
+    }
+}
+
+void ULuaTickSubsystem::Deinitialize()
+{
+    // Components unregister in EndPlay, anything left belongs to states that are gone with the world
+    DEC_DWORD_STAT_BY(STAT_LuaTickedScripts, NumLive);
+    Entries.Empty();
+    EntryIndices.Empty();
+    NumLive = 0;
+
+    Super::Deinitialize();
+}
+
+void ULuaTickSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaBatchedTick);
+
+    if (bNeedsCompact)
+    {
+        Compact();
+    }
+
+    GatherViewLocations();
+
+    const bool bTickInParallel = CVarLuaTickParallel.GetValueOnGameThread();
+    ParallelEntries.Reset();
+
+    // Parallel entries are not counted against the budget, they never run late
+    const double BudgetSeconds = CVarLuaTickBudgetMs.GetValueOnGameThread() / 1000.0;
+    const double StartTime = FPlatformTime::Seconds();
+    bool bOverBudget = false;
+    bool bDeferred = false;
+
+    // Scripts registered by this tick (spawned actors) start next frame. The loop starts where the budget cut off
+    // the previous frame, so deferred scripts come first once there is time again
+    const int32 NumEntries = Entries.Num();
+    const int32 StartEntry = NumEntries > 0 ? FirstEntry % NumEntries : 0;
+    for (int32 Step = 0; Step < NumEntries; ++Step)
+    {
+        // Index instead of a reference, registering from a script may reallocate the array
+        const int32 Index = (StartEntry + Step) % NumEntries;
+        if (!Entries[Index].Component || !Entries[Index].Component->ShouldTickBatched())
+        {
+            continue;
+        }
+
+        {
+            // The component's tick interval applies on top of the LOD level's
+            FEntry& Entry = Entries[Index];
+            const float TimeInterval = FMath::Max(Entry.TimeInterval, Entry.Component->PrimaryComponentTick.TickInterval);
+            Entry.AccumulatedTime += DeltaTime;
+            if (++Entry.FramesSinceTick < Entry.FrameInterval || Entry.AccumulatedTime < TimeInterval)
+            {
+                continue;
+            }
+
+            if (bTickInParallel && Entry.bParallel)
+            {
+                ParallelEntries.Add(Index);
+                continue;
+            }
+
+            if (bOverBudget && Entry.LODLevel > 0)
+            {
+                // Keeps accumulating time until it gets to run
+                if (!bDeferred)
+                {
+                    FirstEntry = Index;
+                    bDeferred = true;
+                }
+                INC_DWORD_STAT(STAT_LuaTicksDeferred);
+                continue;
+            }
+        }
+
+        lua_State* L = Entries[Index].State;
+        LuaTickSubsystem::CallTickFunction(L, Entries[Index].TickRef, Entries[Index].AccumulatedTime);
+        INC_DWORD_STAT(STAT_LuaTicksRun);
+
+        // The script may have destroyed its own actor
+        FEntry& Entry = Entries[Index];
+        Entry.AccumulatedTime = 0.0f;
+        Entry.FramesSinceTick = 0;
+        if (Entry.Component)
+        {
+            UpdateLOD(Entry);
+            if (++Entry.GCCounter >= Entry.Component->GCInterval)
+            {
+                Entry.GCCounter = 0;
+                FLuaStateManager::Get().RunGarbageCollection(L);
+            }
+        }
+
+        if (BudgetSeconds > 0.0 && !bOverBudget)
+        {
+            bOverBudget = FPlatformTime::Seconds() - StartTime > BudgetSeconds;
+        }
+    }
+
+    if (!bDeferred)
+    {
+        FirstEntry = 0;
+    }
+
+    if (ParallelEntries.Num() > 0)
+    {
+        TickParallel();
+    }
+}
+
+void ULuaTickSubsystem::TickParallel()
+{
+    SCOPE_CYCLE_COUNTER(STAT_LuaParallelTick);
+
+    // Scripts ticked on the game thread may have destroyed scripted actors since the entries were collected
+    ParallelEntries.RemoveAll([this](int32 Index) { return Entries[Index].Component == nullptr; });
+
+    // Scripts only read the world here, world changes are recorded. The actor registry is the one index the read
+    // functions fill on first use, so build it while nothing else runs
+    if (ULuaActorRegistrySubsystem* Registry = GetWorld()->GetSubsystem<ULuaActorRegistrySubsystem>())
+    {
+        Registry->EnsureBuilt();
+    }
+
+    // Every component acquires a Lua state of its own, so no two entries share one. Scripts run for very different
+    // times, hence unbalanced scheduling; with a task limit, each task ticks every NumTasks-th script
+    const int32 MaxTasks = CVarLuaTickParallelMaxTasks.GetValueOnGameThread();
+    const int32 NumTasks = MaxTasks > 0 ? FMath::Min(MaxTasks, ParallelEntries.Num()) : ParallelEntries.Num();
+    TArray<FLuaCommandBuffer> CommandBuffers;
+    ParallelForWithTaskContext(TEXT("LuaParallelTick"), CommandBuffers, NumTasks, 1, [this, NumTasks](FLuaCommandBuffer& Commands, int32 TaskIndex)
+    {
+        FLuaCommandBuffer::FScopedRecording Recording(Commands);
+        for (int32 ParallelIndex = TaskIndex; ParallelIndex < ParallelEntries.Num(); ParallelIndex += NumTasks)
+        {
+            FEntry& Entry = Entries[ParallelEntries[ParallelIndex]];
+            LuaTickSubsystem::CallTickFunction(Entry.State, Entry.TickRef, Entry.AccumulatedTime);
+            INC_DWORD_STAT(STAT_LuaTicksRunParallel);
+
+            if (++Entry.GCCounter >= Entry.Component->GCInterval)
+            {
+                Entry.GCCounter = 0;
+                FLuaStateManager::Get().RunGarbageCollection(Entry.State);
+            }
+        }
+    }, EParallelForFlags::Unbalanced);
+
+    // Applied calls run engine code and scripts on the game thread, and may register and unregister components
+    bApplyingCommands = true;
+    for (FLuaCommandBuffer& Commands : CommandBuffers)
+    {
+        Commands.Apply(ReleasedStates);
+    }
+    bApplyingCommands = false;
+    ReleasedStates.Reset();
+
+    for (const int32 Index : ParallelEntries)
+    {
+        FEntry& Entry = Entries[Index];
+        Entry.AccumulatedTime = 0.0f;
+        Entry.FramesSinceTick = 0;
+        if (Entry.Component)
+        {
+            UpdateLOD(Entry);
+        }
+    }
+}
+
+void ULuaTickSubsystem::SetSignificanceHandler(FSignificanceHandler Handler)
+{
+    SignificanceHandler = MoveTemp(Handler);
+}
+
+void ULuaTickSubsystem::GatherViewLocations()
+{
+    ViewLocations.Reset();
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* Controller = It->Get())
+        {
+            FVector Location;
+            FRotator Rotation;
+            Controller->GetPlayerViewPoint(Location, Rotation);
+            ViewLocations.Add(Location);
+        }
+    }
+}
+
+void ULuaTickSubsystem::UpdateLOD(FEntry& Entry) const
+{
+    const TArray<FLuaTickLODLevel>& Levels = Entry.Component->TickLODLevels;
+    if (Levels.Num() == 0)
+    {
+        Entry.LODLevel = 0;
+        Entry.FrameInterval = 1;
+        Entry.TimeInterval = 0.0f;
+        return;
+    }
+
+    int32 Level = 0;
+    if (SignificanceHandler)
+    {
+        Level = FMath::Clamp(SignificanceHandler(*Entry.Component), 0, Levels.Num() - 1);
+    }
+    else if (const AActor* Owner = Entry.Component->GetOwner())
+    {
+        // Without any view (no players yet) every script stays at its first level
+        if (ViewLocations.Num() > 0)
+        {
+            const FVector Location = Owner->GetActorLocation();
+            double DistanceSquared = TNumericLimits<double>::Max();
+            for (const FVector& ViewLocation : ViewLocations)
+            {
+                DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Location, ViewLocation));
+            }
+
+            while (Level < Levels.Num() - 1 && FMath::Square((double)Levels[Level].MaxDistance) < DistanceSquared)
+            {
+                ++Level;
+            }
+        }
+    }
+
+    Entry.LODLevel = Level;
+    Entry.FrameInterval = FMath::Max(Levels[Level].FrameInterval, 1);
+    Entry.TimeInterval = FMath::Max(Levels[Level].TimeInterval, 0.0f);
+}
+
+bool ULuaTickSubsystem::IsTickable() const
+{
+    return NumLive > 0;
+}
+
+TStatId ULuaTickSubsystem::GetStatId() const
+{
+    return GET_STATID(STAT_LuaBatchedTick);
+}
+
+bool ULuaTickSubsystem::Register(ULuaScriptComponent* Component, lua_State* L)
+{
+    Unregister(Component);
+
+    lua_getglobal(L, "tick");
+    if (!lua_isfunction(L, -1))
+    {
+        lua_pop(L, 1);
+        return false;
+    }
+
+    EntryIndices.Add(Component, Entries.Add({ Component, L, luaL_ref(L, LUA_REGISTRYINDEX), 0, Component->bTickInParallel }));
+    ++NumLive;
+    INC_DWORD_STAT(STAT_LuaTickedScripts);
+
+    // Sorted on the next tick, together with other registrations of the frame
+    bNeedsCompact = true;
+    return true;
+}
+
+void ULuaTickSubsystem::Unregister(ULuaScriptComponent* Component)
+{
+    int32 Index;
+    if (!EntryIndices.RemoveAndCopyValue(Component, Index))
+    {
+        return;
+    }
+
+    // Removed from the array on the next tick, which keeps unregistering many components cheap
+    FEntry& Entry = Entries[Index];
+    luaL_unref(Entry.State, LUA_REGISTRYINDEX, Entry.TickRef);
+    if (bApplyingCommands)
+    {
+        // The state is released after this, calls it still has recorded must not run
+        ReleasedStates.Add(Entry.State);
+    }
+    Entry.Component = nullptr;
+    --NumLive;
+    DEC_DWORD_STAT(STAT_LuaTickedScripts);
+    bNeedsCompact = true;
+}
+
+void ULuaTickSubsystem::Compact()
+{
+    // Removing and sorting moves entries, keep the frame starting with the first deferred script that is still registered
+    ULuaScriptComponent* FirstComponent = nullptr;
+    for (int32 Index = FirstEntry; Index < Entries.Num() && !FirstComponent; ++Index)
+    {
+        FirstComponent = Entries[Index].Component;
+    }
+
+    Entries.RemoveAllSwap([](const FEntry& Entry) { return Entry.Component == nullptr; }, EAllowShrinking::No);
+    Entries.Sort([](const FEntry& A, const FEntry& B) { return A.State < B.State; });
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        EntryIndices.Add(Entries[Index].Component, Index);
+    }
+    FirstEntry = FirstComponent ? EntryIndices.FindChecked(FirstComponent) : 0;
+    bNeedsCompact = false;
+}
+
+bool ULuaTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
\ No newline at end of file
@@ -0,0 +1,993 @@
+#include "LuaValueTypes.h"
+#include "LuaStateManager.h"
+#include "LuaStringBridge.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Value types created"), STAT_LuaValueTypesCreated, STATGROUP_LuaScripting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Value types reused"), STAT_LuaValueTypesReused, STATGROUP_LuaScripting);
+
+namespace LuaValueTypes
+{
+    /**
+     * Per-type description used by the shared userdata plumbing below
+     * Name is the registry name of the metatable, Fields lists the field names in field index order
+     */
+    template<typename T>
+    struct TTraits;
+
+    template<>
+    struct TTraits<FVector>
+    {
+        static constexpr const char* Name = "FVector";
+        static constexpr const char* Fields[] = { "X", "Y", "Z" };
+
+        static void PushField(lua_State* L, const FVector& Value, int32 Field)
+        {
+            lua_pushnumber(L, Value[Field]);
+        }
+
+        static void SetField(lua_State* L, FVector& Value, int32 Field, int ValueIndex)
+        {
+            Value[Field] = luaL_checknumber(L, ValueIndex);
+        }
+
+        static bool Equals(const FVector& A, const FVector& B)
+        {
+            return A == B;
+        }
+    };
+
+    template<>
+    struct TTraits<FRotator>
+    {
+        static constexpr const char* Name = "FRotator";
+        static constexpr const char* Fields[] = { "Pitch", "Yaw", "Roll" };
+
+        static FRotator::FReal& Component(FRotator& Value, int32 Field)
+        {
+            return Field == 0 ? Value.Pitch : (Field == 1 ? Value.Yaw : Value.Roll);
+        }
+
+        static void PushField(lua_State* L, const FRotator& Value, int32 Field)
+        {
+            lua_pushnumber(L, Component(const_cast<FRotator&>(Value), Field));
+        }
+
+        static void SetField(lua_State* L, FRotator& Value, int32 Field, int ValueIndex)
+        {
+            Component(Value, Field) = luaL_checknumber(L, ValueIndex);
+        }
+
+        static bool Equals(const FRotator& A, const FRotator& B)
+        {
+            return A == B;
+        }
+    };
+
+    template<>
+    struct TTraits<FQuat>
+    {
+        static constexpr const char* Name = "FQuat";
+        static constexpr const char* Fields[] = { "X", "Y", "Z", "W" };
+
+        static FQuat::FReal& Component(FQuat& Value, int32 Field)
+        {
+            switch (Field)
+            {
+            case 0: return Value.X;
+            case 1: return Value.Y;
+            case 2: return Value.Z;
+            default: return Value.W;
+            }
+        }
+
+        static void PushField(lua_State* L, const FQuat& Value, int32 Field)
+        {
+            lua_pushnumber(L, Component(const_cast<FQuat&>(Value), Field));
+        }
+
+        static void SetField(lua_State* L, FQuat& Value, int32 Field, int ValueIndex)
+        {
+            Component(Value, Field) = luaL_checknumber(L, ValueIndex);
+        }
+
+        static bool Equals(const FQuat& A, const FQuat& B)
+        {
+            return A == B;
+        }
+    };
+
+    template<>
+    struct TTraits<FTransform>
+    {
+        static constexpr const char* Name = "FTransform";
+        static constexpr const char* Fields[] = { "Location", "Rotation", "Quat", "Scale3D" };
+
+        static void PushField(lua_State* L, const FTransform& Value, int32 Field)
+        {
+            switch (Field)
+            {
+            case 0: FLuaValueTypes::PushVector(L, Value.GetLocation()); break;
+            case 1: FLuaValueTypes::PushRotator(L, Value.Rotator()); break;
+            case 2: FLuaValueTypes::PushQuat(L, Value.GetRotation()); break;
+            default: FLuaValueTypes::PushVector(L, Value.GetScale3D()); break;
+            }
+        }
+
+        static void SetField(lua_State* L, FTransform& Value, int32 Field, int ValueIndex)
+        {
+            switch (Field)
+            {
+            case 0: Value.SetLocation(FLuaValueTypes::CheckVector(L, ValueIndex)); break;
+            case 1:
+            case 2: Value.SetRotation(FLuaValueTypes::CheckQuat(L, ValueIndex)); break;
+            default: Value.SetScale3D(FLuaValueTypes::CheckVector(L, ValueIndex)); break;
+            }
+        }
+
+        static bool Equals(const FTransform& A, const FTransform& B)
+        {
+            return A.Equals(B, 0.0);
+        }
+    };
+
+    // Lua only guarantees pointer/double alignment for userdata memory, so over-allocate for SIMD aligned types
+    template<typename T>
+    constexpr size_t StorageSize()
+    {
+        return alignof(T) > alignof(double) ? sizeof(T) + alignof(T) : sizeof(T);
+    }
+
+    template<typename T>
+    FORCEINLINE T* FromStorage(void* Storage)
+    {
+        return static_cast<T*>(Align(Storage, alignof(T)));
+    }
+
+    template<typename T>
+    T* New(lua_State* L, const T& Value)
+    {
+        INC_DWORD_STAT(STAT_LuaValueTypesCreated);
+        T* Data = FromStorage<T>(lua_newuserdatauv(L, StorageSize<T>(), 0));
+        new (Data) T(Value);
+        luaL_setmetatable(L, TTraits<T>::Name);
+        return Data;
+    }
+
+    template<typename T>
+    T* Test(lua_State* L, int Index)
+    {
+        void* Storage = luaL_testudata(L, Index, TTraits<T>::Name);
+        return Storage ? FromStorage<T>(Storage) : nullptr;
+    }
+
+    template<typename T>
+    T* Check(lua_State* L, int Index)
+    {
+        return FromStorage<T>(luaL_checkudata(L, Index, TTraits<T>::Name));
+    }
+
+    // Push a field of Value to store in a destination table, OldIndex holds the table's current value of the field
+    template<typename T>
+    void PushTableField(lua_State* L, const T& Value, int32 Field, int OldIndex)
+    {
+        TTraits<T>::PushField(L, Value, Field);
+    }
+
+    // Write into the userdata or table at OutIndex and push it, or push a new value if no destination was passed
+    template<typename T>
+    void PushInto(lua_State* L, const T& Value, int OutIndex)
+    {
+        if (OutIndex == 0 || lua_isnoneornil(L, OutIndex))
+        {
+            New<T>(L, Value);
+            return;
+        }
+
+        INC_DWORD_STAT(STAT_LuaValueTypesReused);
+        if (!lua_istable(L, OutIndex))
+        {
+            *Check<T>(L, OutIndex) = Value;
+            lua_pushvalue(L, OutIndex);
+            return;
+        }
+
+        // Legacy tables get the same named fields the readers accept
+        constexpr int32 NumFields = UE_ARRAY_COUNT(TTraits<T>::Fields);
+        OutIndex = lua_absindex(L, OutIndex);
+        for (int32 Field = 0; Field < NumFields; ++Field)
+        {
+            lua_getfield(L, OutIndex, TTraits<T>::Fields[Field]);
+            PushTableField<T>(L, Value, Field, lua_gettop(L));
+            lua_setfield(L, OutIndex, TTraits<T>::Fields[Field]);
+            lua_pop(L, 1);
+        }
+        lua_pushvalue(L, OutIndex);
+    }
+
+    // Transform tables hold value types, which are written in place when the table already has them
+    template<>
+    void PushTableField<FTransform>(lua_State* L, const FTransform& Value, int32 Field, int OldIndex)
+    {
+        // Fields of another type are replaced
+        const bool bReuse = Field == 1 ? Test<FRotator>(L, OldIndex) != nullptr
+            : Field == 2 ? Test<FQuat>(L, OldIndex) != nullptr
+            : Test<FVector>(L, OldIndex) != nullptr;
+        const int DestinationIndex = bReuse ? OldIndex : 0;
+
+        switch (Field)
+        {
+        case 0: PushInto<FVector>(L, Value.GetLocation(), DestinationIndex); break;
+        case 1: PushInto<FRotator>(L, Value.Rotator(), DestinationIndex); break;
+        case 2: PushInto<FQuat>(L, Value.GetRotation(), DestinationIndex); break;
+        default: PushInto<FVector>(L, Value.GetScale3D(), DestinationIndex); break;
+        }
+    }
+
+    // Read the named numeric fields of a legacy table, leaving missing fields at their current value
+    template<int32 NumFields>
+    void ReadTableFields(lua_State* L, int Index, const char* const (&Names)[NumFields], double (&OutValues)[NumFields])
+    {
+        Index = lua_absindex(L, Index);
+        for (int32 Field = 0; Field < NumFields; ++Field)
+        {
+            lua_getfield(L, Index, Names[Field]);
+            int bIsNumber = 0;
+            const lua_Number Value = lua_tonumberx(L, -1, &bIsNumber);
+            if (bIsNumber)
+            {
+                OutValues[Field] = Value;
+            }
+            lua_pop(L, 1);
+        }
+    }
+
+    // __index: the upvalue table maps field names to field indices and method names to functions
+    template<typename T>
+    int Index(lua_State* L)
+    {
+        const T* Value = Check<T>(L, 1);
+
+        lua_pushvalue(L, 2);
+        if (lua_rawget(L, lua_upvalueindex(1)) == LUA_TNUMBER)
+        {
+            const int32 Field = (int32)lua_tointeger(L, -1);
+            lua_pop(L, 1);
+            TTraits<T>::PushField(L, *Value, Field);
+        }
+
+        return 1;
+    }
+
+    // __newindex: only fields can be assigned
+    template<typename T>
+    int NewIndex(lua_State* L)
+    {
+        T* Value = Check<T>(L, 1);
+
+        lua_pushvalue(L, 2);
+        if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TNUMBER)
+        {
+            return luaL_error(L, "%s has no field '%s'", TTraits<T>::Name, luaL_tolstring(L, 2, nullptr));
+        }
+
+        TTraits<T>::SetField(L, *Value, (int32)lua_tointeger(L, -1), 3);
+        return 0;
+    }
+
+    template<typename T>
+    int ToString(lua_State* L)
+    {
+        FLuaStringBridge::PushString(L, Check<T>(L, 1)->ToString());
+        return 1;
+    }
+
+    template<typename T>
+    int Equals(lua_State* L)
+    {
+        const T* A = Test<T>(L, 1);
+        const T* B = Test<T>(L, 2);
+        lua_pushboolean(L, A && B && TTraits<T>::Equals(*A, *B));
+        return 1;
+    }
+
+    template<typename T>
+    int Copy(lua_State* L)
+    {
+        New<T>(L, *Check<T>(L, 1));
+        return 1;
+    }
+
+    template<typename T>
+    void RegisterType(lua_State* L, const luaL_Reg* Methods, const luaL_Reg* MetaMethods)
+    {
+        if (luaL_newmetatable(L, TTraits<T>::Name))
+        {
+            // Lookup table shared by __index and __newindex
+            lua_newtable(L);
+            for (int32 Field = 0; Field < (int32)UE_ARRAY_COUNT(TTraits<T>::Fields); ++Field)
+            {
+                lua_pushinteger(L, Field);
+                lua_setfield(L, -2, TTraits<T>::Fields[Field]);
+            }
+            luaL_setfuncs(L, Methods, 0);
+
+            lua_pushvalue(L, -1);
+            lua_pushcclosure(L, Index<T>, 1);
+            lua_setfield(L, -3, "__index");
+
+            lua_pushcclosure(L, NewIndex<T>, 1);
+            lua_setfield(L, -2, "__newindex");
+
+            lua_pushcfunction(L, ToString<T>);
+            lua_setfield(L, -2, "__tostring");
+
+            lua_pushcfunction(L, Equals<T>);
+            lua_setfield(L, -2, "__eq");
+
+            luaL_setfuncs(L, MetaMethods, 0);
+        }
+
+        // Pop the metatable
+        lua_pop(L, 1);
+    }
+
+    // Arithmetic operands may be vectors, legacy tables or plain numbers (applied to every component)
+    FVector CheckVectorOperand(lua_State* L, int Index)
+    {
+        if (lua_type(L, Index) == LUA_TNUMBER)
+        {
+            return FVector(lua_tonumber(L, Index));
+        }
+        return FLuaValueTypes::CheckVector(L, Index);
+    }
+
+    // FVector
+
+    int Vector_New(lua_State* L)
+    {
+        FLuaValueTypes::PushVector(L, FVector(luaL_optnumber(L, 1, 0.0), luaL_optnumber(L, 2, 0.0), luaL_optnumber(L, 3, 0.0)));
+        return 1;
+    }
+
+    int Vector_Add(lua_State* L)
+    {
+        FLuaValueTypes::PushVector(L, CheckVectorOperand(L, 1) + CheckVectorOperand(L, 2));
+        return 1;
+    }
+
+    int Vector_Sub(lua_State* L)
+    {
+        FLuaValueTypes::PushVector(L, CheckVectorOperand(L, 1) - CheckVectorOperand(L, 2));
+        return 1;
+    }
+
+    int Vector_Mul(lua_State* L)
+    {
+        FLuaValueTypes::PushVector(L, CheckVectorOperand(L, 1) * CheckVectorOperand(L, 2));
+        return 1;
+    }
+
+    int Vector_Div(lua_State* L)
+    {
+        FLuaValueTypes::PushVector(L, CheckVectorOperand(L, 1) / CheckVectorOperand(L, 2));
+        return 1;
+    }
+
+    int Vector_Unm(lua_State* L)
+    {
+        FLuaValueTypes::PushVector(L, -*Check<FVector>(L, 1));
+        return 1;
+    }
+
+    int Vector_Dot(lua_State* L)
+    {
+        lua_pushnumber(L, FVector::DotProduct(*Check<FVector>(L, 1), FLuaValueTypes::CheckVector(L, 2)));
+        return 1;
+    }
+
+    int Vector_Cross(lua_State* L)
+    {
+        PushInto<FVector>(L, FVector::CrossProduct(*Check<FVector>(L, 1), FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Vector_Size(lua_State* L)
+    {
+        lua_pushnumber(L, Check<FVector>(L, 1)->Size());
+        return 1;
+    }
+
+    int Vector_SizeSquared(lua_State* L)
+    {
+        lua_pushnumber(L, Check<FVector>(L, 1)->SizeSquared());
+        return 1;
+    }
+
+    int Vector_Size2D(lua_State* L)
+    {
+        lua_pushnumber(L, Check<FVector>(L, 1)->Size2D());
+        return 1;
+    }
+
+    int Vector_Normalize(lua_State* L)
+    {
+        // Normalizes in place, mirroring FVector::Normalize
+        FVector* Value = Check<FVector>(L, 1);
+        lua_pushboolean(L, Value->Normalize(luaL_optnumber(L, 2, UE_SMALL_NUMBER)));
+        return 1;
+    }
+
+    int Vector_GetSafeNormal(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FVector>(L, 1)->GetSafeNormal(luaL_optnumber(L, 2, UE_SMALL_NUMBER)), 3);
+        return 1;
+    }
+
+    int Vector_Distance(lua_State* L)
+    {
+        lua_pushnumber(L, FVector::Dist(*Check<FVector>(L, 1), FLuaValueTypes::CheckVector(L, 2)));
+        return 1;
+    }
+
+    int Vector_Rotation(lua_State* L)
+    {
+        PushInto<FRotator>(L, Check<FVector>(L, 1)->Rotation(), 2);
+        return 1;
+    }
+
+    int Vector_Set(lua_State* L)
+    {
+        FVector* Value = Check<FVector>(L, 1);
+        Value->Set(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4));
+        lua_settop(L, 1);
+        return 1;
+    }
+
+    const luaL_Reg VectorMethods[] = {
+        { "Dot", Vector_Dot },
+        { "Cross", Vector_Cross },
+        { "Size", Vector_Size },
+        { "SizeSquared", Vector_SizeSquared },
+        { "Size2D", Vector_Size2D },
+        { "Normalize", Vector_Normalize },
+        { "GetSafeNormal", Vector_GetSafeNormal },
+        { "Distance", Vector_Distance },
+        { "Rotation", Vector_Rotation },
+        { "Set", Vector_Set },
+        { "Copy", Copy<FVector> },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg VectorMetaMethods[] = {
+        { "__add", Vector_Add },
+        { "__sub", Vector_Sub },
+        { "__mul", Vector_Mul },
+        { "__div", Vector_Div },
+        { "__unm", Vector_Unm },
+        { nullptr, nullptr }
+    };
+
+    // FRotator
+
+    int Rotator_New(lua_State* L)
+    {
+        FLuaValueTypes::PushRotator(L, FRotator(luaL_optnumber(L, 1, 0.0), luaL_optnumber(L, 2, 0.0), luaL_optnumber(L, 3, 0.0)));
+        return 1;
+    }
+
+    int Rotator_Add(lua_State* L)
+    {
+        FLuaValueTypes::PushRotator(L, FLuaValueTypes::CheckRotator(L, 1) + FLuaValueTypes::CheckRotator(L, 2));
+        return 1;
+    }
+
+    int Rotator_Sub(lua_State* L)
+    {
+        FLuaValueTypes::PushRotator(L, FLuaValueTypes::CheckRotator(L, 1) - FLuaValueTypes::CheckRotator(L, 2));
+        return 1;
+    }
+
+    int Rotator_Mul(lua_State* L)
+    {
+        // Scaling by a number is supported from either side
+        const int RotatorIndex = lua_type(L, 1) == LUA_TNUMBER ? 2 : 1;
+        const int ScaleIndex = RotatorIndex == 1 ? 2 : 1;
+        FLuaValueTypes::PushRotator(L, FLuaValueTypes::CheckRotator(L, RotatorIndex) * luaL_checknumber(L, ScaleIndex));
+        return 1;
+    }
+
+    int Rotator_Vector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FRotator>(L, 1)->Vector(), 2);
+        return 1;
+    }
+
+    int Rotator_Quaternion(lua_State* L)
+    {
+        PushInto<FQuat>(L, Check<FRotator>(L, 1)->Quaternion(), 2);
+        return 1;
+    }
+
+    int Rotator_RotateVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FRotator>(L, 1)->RotateVector(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Rotator_UnrotateVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FRotator>(L, 1)->UnrotateVector(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Rotator_Normalize(lua_State* L)
+    {
+        // Normalizes in place, mirroring FRotator::Normalize
+        Check<FRotator>(L, 1)->Normalize();
+        lua_settop(L, 1);
+        return 1;
+    }
+
+    int Rotator_GetNormalized(lua_State* L)
+    {
+        PushInto<FRotator>(L, Check<FRotator>(L, 1)->GetNormalized(), 2);
+        return 1;
+    }
+
+    int Rotator_GetInverse(lua_State* L)
+    {
+        PushInto<FRotator>(L, Check<FRotator>(L, 1)->GetInverse(), 2);
+        return 1;
+    }
+
+    int Rotator_Set(lua_State* L)
+    {
+        FRotator* Value = Check<FRotator>(L, 1);
+        *Value = FRotator(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4));
+        lua_settop(L, 1);
+        return 1;
+    }
+
+    const luaL_Reg RotatorMethods[] = {
+        { "Vector", Rotator_Vector },
+        { "Quaternion", Rotator_Quaternion },
+        { "RotateVector", Rotator_RotateVector },
+        { "UnrotateVector", Rotator_UnrotateVector },
+        { "Normalize", Rotator_Normalize },
+        { "GetNormalized", Rotator_GetNormalized },
+        { "GetInverse", Rotator_GetInverse },
+        { "Set", Rotator_Set },
+        { "Copy", Copy<FRotator> },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg RotatorMetaMethods[] = {
+        { "__add", Rotator_Add },
+        { "__sub", Rotator_Sub },
+        { "__mul", Rotator_Mul },
+        { nullptr, nullptr }
+    };
+
+    // FQuat
+
+    int Quat_New(lua_State* L)
+    {
+        if (lua_gettop(L) == 0)
+        {
+            FLuaValueTypes::PushQuat(L, FQuat::Identity);
+        }
+        else if (lua_type(L, 1) == LUA_TNUMBER)
+        {
+            FLuaValueTypes::PushQuat(L, FQuat(luaL_checknumber(L, 1), luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4)));
+        }
+        else
+        {
+            FLuaValueTypes::PushQuat(L, FLuaValueTypes::CheckQuat(L, 1));
+        }
+        return 1;
+    }
+
+    int Quat_Mul(lua_State* L)
+    {
+        const FQuat& A = *Check<FQuat>(L, 1);
+
+        // Quat * Quat (or rotator) composes the rotations, Quat * Vector rotates the vector. Any table reads as a
+        // vector, so quats and rotators ({W} and {Pitch} tables included) are checked first
+        bool bIsRotation = FLuaValueTypes::ToQuatUserdata(L, 2) || FLuaValueTypes::ToRotatorUserdata(L, 2);
+        if (!bIsRotation && lua_istable(L, 2))
+        {
+            bIsRotation = lua_getfield(L, 2, "W") != LUA_TNIL || lua_getfield(L, 2, "Pitch") != LUA_TNIL;
+            lua_settop(L, 2);
+        }
+
+        if (bIsRotation)
+        {
+            FLuaValueTypes::PushQuat(L, A * FLuaValueTypes::CheckQuat(L, 2));
+        }
+        else
+        {
+            FLuaValueTypes::PushVector(L, A.RotateVector(FLuaValueTypes::CheckVector(L, 2)));
+        }
+        return 1;
+    }
+
+    int Quat_Rotator(lua_State* L)
+    {
+        PushInto<FRotator>(L, Check<FQuat>(L, 1)->Rotator(), 2);
+        return 1;
+    }
+
+    int Quat_RotateVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FQuat>(L, 1)->RotateVector(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Quat_UnrotateVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FQuat>(L, 1)->UnrotateVector(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Quat_Inverse(lua_State* L)
+    {
+        PushInto<FQuat>(L, Check<FQuat>(L, 1)->Inverse(), 2);
+        return 1;
+    }
+
+    int Quat_Normalize(lua_State* L)
+    {
+        // Normalizes in place, mirroring FQuat::Normalize
+        Check<FQuat>(L, 1)->Normalize();
+        lua_settop(L, 1);
+        return 1;
+    }
+
+    int Quat_GetNormalized(lua_State* L)
+    {
+        PushInto<FQuat>(L, Check<FQuat>(L, 1)->GetNormalized(), 2);
+        return 1;
+    }
+
+    int Quat_Size(lua_State* L)
+    {
+        lua_pushnumber(L, Check<FQuat>(L, 1)->Size());
+        return 1;
+    }
+
+    int Quat_GetForwardVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FQuat>(L, 1)->GetForwardVector(), 2);
+        return 1;
+    }
+
+    int Quat_GetRightVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FQuat>(L, 1)->GetRightVector(), 2);
+        return 1;
+    }
+
+    int Quat_GetUpVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FQuat>(L, 1)->GetUpVector(), 2);
+        return 1;
+    }
+
+    const luaL_Reg QuatMethods[] = {
+        { "Rotator", Quat_Rotator },
+        { "RotateVector", Quat_RotateVector },
+        { "UnrotateVector", Quat_UnrotateVector },
+        { "Inverse", Quat_Inverse },
+        { "Normalize", Quat_Normalize },
+        { "GetNormalized", Quat_GetNormalized },
+        { "Size", Quat_Size },
+        { "GetForwardVector", Quat_GetForwardVector },
+        { "GetRightVector", Quat_GetRightVector },
+        { "GetUpVector", Quat_GetUpVector },
+        { "Copy", Copy<FQuat> },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg QuatMetaMethods[] = {
+        { "__mul", Quat_Mul },
+        { nullptr, nullptr }
+    };
+
+    // FTransform
+
+    int Transform_New(lua_State* L)
+    {
+        FTransform Transform = FTransform::Identity;
+        if (!lua_isnoneornil(L, 1))
+        {
+            Transform.SetLocation(FLuaValueTypes::CheckVector(L, 1));
+        }
+        if (!lua_isnoneornil(L, 2))
+        {
+            Transform.SetRotation(FLuaValueTypes::CheckQuat(L, 2));
+        }
+        if (!lua_isnoneornil(L, 3))
+        {
+            Transform.SetScale3D(FLuaValueTypes::CheckVector(L, 3));
+        }
+
+        FLuaValueTypes::PushTransform(L, Transform);
+        return 1;
+    }
+
+    int Transform_Mul(lua_State* L)
+    {
+        FLuaValueTypes::PushTransform(L, *Check<FTransform>(L, 1) * *Check<FTransform>(L, 2));
+        return 1;
+    }
+
+    int Transform_TransformPosition(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FTransform>(L, 1)->TransformPosition(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Transform_TransformVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FTransform>(L, 1)->TransformVector(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Transform_InverseTransformPosition(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FTransform>(L, 1)->InverseTransformPosition(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Transform_InverseTransformVector(lua_State* L)
+    {
+        PushInto<FVector>(L, Check<FTransform>(L, 1)->InverseTransformVector(FLuaValueTypes::CheckVector(L, 2)), 3);
+        return 1;
+    }
+
+    int Transform_Inverse(lua_State* L)
+    {
+        PushInto<FTransform>(L, Check<FTransform>(L, 1)->Inverse(), 2);
+        return 1;
+    }
+
+    const luaL_Reg TransformMethods[] = {
+        { "TransformPosition", Transform_TransformPosition },
+        { "TransformVector", Transform_TransformVector },
+        { "InverseTransformPosition", Transform_InverseTransformPosition },
+        { "InverseTransformVector", Transform_InverseTransformVector },
+        { "Inverse", Transform_Inverse },
+        { "Copy", Copy<FTransform> },
+        { nullptr, nullptr }
+    };
+
+    const luaL_Reg TransformMetaMethods[] = {
+        { "__mul", Transform_Mul },
+        { nullptr, nullptr }
+    };
+}
+
+void FLuaValueTypes::Register(lua_State* L)
+{
+    using namespace LuaValueTypes;
+
+    RegisterType<FVector>(L, VectorMethods, VectorMetaMethods);
+    RegisterType<FRotator>(L, RotatorMethods, RotatorMetaMethods);
+    RegisterType<FQuat>(L, QuatMethods, QuatMetaMethods);
+    RegisterType<FTransform>(L, TransformMethods, TransformMetaMethods);
+
+    // Register the constructors in the UE namespace
+    lua_getglobal(L, "UE");
+
+    lua_pushcfunction(L, Vector_New);
+    lua_setfield(L, -2, "Vector");
+
+    lua_pushcfunction(L, Rotator_New);
+    lua_setfield(L, -2, "Rotator");
+
+    lua_pushcfunction(L, Quat_New);
+    lua_setfield(L, -2, "Quat");
+
+    lua_pushcfunction(L, Transform_New);
+    lua_setfield(L, -2, "Transform");
+
+    // Pop the UE table
+    lua_pop(L, 1);
+}
+
+void FLuaValueTypes::PushVector(lua_State* L, const FVector& Value)
+{
+    LuaValueTypes::New<FVector>(L, Value);
+}
+
+void FLuaValueTypes::PushVector(lua_State* L, const FVector& Value, int OutIndex)
+{
+    LuaValueTypes::PushInto<FVector>(L, Value, OutIndex);
+}
+
+void FLuaValueTypes::PushRotator(lua_State* L, const FRotator& Value)
+{
+    LuaValueTypes::New<FRotator>(L, Value);
+}
+
+void FLuaValueTypes::PushRotator(lua_State* L, const FRotator& Value, int OutIndex)
+{
+    LuaValueTypes::PushInto<FRotator>(L, Value, OutIndex);
+}
+
+void FLuaValueTypes::PushQuat(lua_State* L, const FQuat& Value)
+{
+    LuaValueTypes::New<FQuat>(L, Value);
+}
+
+void FLuaValueTypes::PushQuat(lua_State* L, const FQuat& Value, int OutIndex)
+{
+    LuaValueTypes::PushInto<FQuat>(L, Value, OutIndex);
+}
+
+void FLuaValueTypes::PushTransform(lua_State* L, const FTransform& Value)
+{
+    LuaValueTypes::New<FTransform>(L, Value);
+}
+
+void FLuaValueTypes::PushTransform(lua_State* L, const FTransform& Value, int OutIndex)
+{
+    LuaValueTypes::PushInto<FTransform>(L, Value, OutIndex);
+}
+
+FVector* FLuaValueTypes::ToVectorUserdata(lua_State* L, int Index)
+{
+    return LuaValueTypes::Test<FVector>(L, Index);
+}
+
+FRotator* FLuaValueTypes::ToRotatorUserdata(lua_State* L, int Index)
+{
+    return LuaValueTypes::Test<FRotator>(L, Index);
+}
+
+FQuat* FLuaValueTypes::ToQuatUserdata(lua_State* L, int Index)
+{
+    return LuaValueTypes::Test<FQuat>(L, Index);
+}
+
+FTransform* FLuaValueTypes::ToTransformUserdata(lua_State* L, int Index)
+{
+    return LuaValueTypes::Test<FTransform>(L, Index);
+}
+
+bool FLuaValueTypes::GetVector(lua_State* L, int Index, FVector& OutValue)
+{
+    if (const FVector* Value = ToVectorUserdata(L, Index))
+    {
+        OutValue = *Value;
+        return true;
+    }
+
+    // Legacy {X, Y, Z} table
+    if (lua_istable(L, Index))
+    {
+        double Components[3] = { 0.0, 0.0, 0.0 };
+        LuaValueTypes::ReadTableFields(L, Index, LuaValueTypes::TTraits<FVector>::Fields, Components);
+        OutValue = FVector(Components[0], Components[1], Components[2]);
+        return true;
+    }
+
+    return false;
+}
+
+bool FLuaValueTypes::GetRotator(lua_State* L, int Index, FRotator& OutValue)
+{
+    if (const FRotator* Value = ToRotatorUserdata(L, Index))
+    {
+        OutValue = *Value;
+        return true;
+    }
+
+    if (const FQuat* Quat = ToQuatUserdata(L, Index))
+    {
+        OutValue = Quat->Rotator();
+        return true;
+    }
+
+    // Legacy {Pitch, Yaw, Roll} table
+    if (lua_istable(L, Index))
+    {
+        double Components[3] = { 0.0, 0.0, 0.0 };
+        LuaValueTypes::ReadTableFields(L, Index, LuaValueTypes::TTraits<FRotator>::Fields, Components);
+        OutValue = FRotator(Components[0], Components[1], Components[2]);
+        return true;
+    }
+
+    return false;
+}
+
+bool FLuaValueTypes::GetQuat(lua_State* L, int Index, FQuat& OutValue)
+{
+    if (const FQuat* Value = ToQuatUserdata(L, Index))
+    {
+        OutValue = *Value;
+        return true;
+    }
+
+    // {X, Y, Z, W} table, as filled when a table is the destination of a quat
+    if (lua_istable(L, Index))
+    {
+        const bool bHasW = lua_getfield(L, Index, "W") == LUA_TNUMBER;
+        lua_pop(L, 1);
+        if (bHasW)
+        {
+            double Components[4] = { 0.0, 0.0, 0.0, 1.0 };
+            LuaValueTypes::ReadTableFields(L, Index, LuaValueTypes::TTraits<FQuat>::Fields, Components);
+            OutValue = FQuat(Components[0], Components[1], Components[2], Components[3]);
+            return true;
+        }
+    }
+
+    // Rotators (userdata or table) are converted
+    FRotator Rotator;
+    if (GetRotator(L, Index, Rotator))
+    {
+        OutValue = Rotator.Quaternion();
+        return true;
+    }
+
+    return false;
+}
+
+bool FLuaValueTypes::GetTransform(lua_State* L, int Index, FTransform& OutValue)
+{
+    if (const FTransform* Value = ToTransformUserdata(L, Index))
+    {
+        OutValue = *Value;
+        return true;
+    }
+
+    return false;
+}
+
+FVector FLuaValueTypes::CheckVector(lua_State* L, int Index)
+{
+    FVector Value;
+    if (!GetVector(L, Index, Value))
+    {
+        luaL_typeerror(L, Index, LuaValueTypes::TTraits<FVector>::Name);
+    }
+    return Value;
+}
+
+FRotator FLuaValueTypes::CheckRotator(lua_State* L, int Index)
+{
+    FRotator Value;
+    if (!GetRotator(L, Index, Value))
+    {
+        luaL_typeerror(L, Index, LuaValueTypes::TTraits<FRotator>::Name);
+    }
+    return Value;
+}
+
+FQuat FLuaValueTypes::CheckQuat(lua_State* L, int Index)
+{
+    FQuat Value;
+    if (!GetQuat(L, Index, Value))
+    {
+        luaL_typeerror(L, Index, LuaValueTypes::TTraits<FQuat>::Name);
+    }
+    return Value;
+}
+
+FTransform FLuaValueTypes::CheckTransform(lua_State* L, int Index)
+{
+    FTransform Value;
+    if (!GetTransform(L, Index, Value))
+    {
+        luaL_typeerror(L, Index, LuaValueTypes::TTraits<FTransform>::Name);
+    }
+    return Value;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+
+namespace LuaActorPoolPerfTest
+{
+    constexpr int32 WaveSize = 200;
+
+    // A wave of projectiles fired and removed, spawned and destroyed or taken from and returned to the pool
+    const TCHAR* Script = TEXT(R"(
+        local N = 200
+        local wave = {}
+        local location = UE.Vector(0, 0, 0)
+
+        function spawnWave()
+            for i = 1, N do
+                wave[i] = UE.Actor.SpawnActor("Actor", i, 0, 0)
+            end
+            for i = 1, N do
+                UE.Actor.DestroyActor(wave[i])
+                wave[i] = nil
+            end
+        end
+
+        function poolWave()
+            for i = 1, N do
+                location:Set(i, 0, 0)
+                wave[i] = UE.Actor.Acquire("Actor", location)
+            end
+            for i = 1, N do
+                UE.Actor.Release(wave[i])
+                wave[i] = nil
+            end
+        end
+
+        function prewarm()
+            UE.Actor.Prewarm("Actor", N)
+        end
+
+        function spawned()
+            return UE.Actor.GetPoolStats("Actor").Spawned
+        end
+    )");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaActorPoolPerfTest, "LuaScripting.Perf.ActorPool",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaActorPoolPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaActorPoolPerfTest;
+
+    FLuaTestWorld World;
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+
+    const double SpawnMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("spawnWave"), 20);
+
+    Component->CallFunction(TEXT("prewarm"), ErrorMessage);
+    const double PoolMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("poolWave"), 20);
+
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("Wave of %d actors, spawn and destroy vs acquire and release"), WaveSize), SpawnMicroseconds, PoolMicroseconds);
+
+    // Every wave after the prewarm reused the pooled actors
+    lua_State* L = Component->GetLuaState();
+    lua_getglobal(L, "spawned");
+    TestTrue(TEXT("Pool stats read"), lua_pcall(L, 0, 1, 0) == LUA_OK);
+    TestEqual(TEXT("Actors spawned by the pool"), (int32)lua_tointeger(L, -1), WaveSize);
+    lua_pop(L, 1);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
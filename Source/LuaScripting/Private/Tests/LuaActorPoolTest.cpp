@@ -0,0 +1,55 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaActorPoolSubsystem.h"
+#include "LuaTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaActorPoolTest, "LuaScripting.ActorPool.AcquireRelease",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FLuaActorPoolTest::RunTest(const FString& Parameters)
+{
+    FLuaTestWorld World;
+    ULuaActorPoolSubsystem* Pool = World.GetSubsystem<ULuaActorPoolSubsystem>();
+    if (!TestNotNull(TEXT("Pool subsystem"), Pool))
+    {
+        return false;
+    }
+
+    UClass* Class = AActor::StaticClass();
+    TestEqual(TEXT("Prewarmed actors"), Pool->Prewarm(Class, 2), 2);
+    TestEqual(TEXT("Free after prewarm"), Pool->GetStats(Class).NumFree, 2);
+
+    // Acquire hands out a pooled actor and re-enables it
+    AActor* Actor = Pool->Acquire(Class, FTransform::Identity);
+    if (!TestNotNull(TEXT("Acquired actor"), Actor))
+    {
+        return false;
+    }
+    TestFalse(TEXT("Acquired actor is visible"), Actor->IsHidden());
+    TestEqual(TEXT("Reused actors"), Pool->GetStats(Class).NumReused, 1);
+    TestEqual(TEXT("Spawned actors"), Pool->GetStats(Class).NumSpawned, 2);
+
+    // Release hides it again, releasing twice is refused
+    TestTrue(TEXT("Released"), Pool->Release(Actor));
+    TestTrue(TEXT("Released actor is hidden"), Actor->IsHidden());
+    TestFalse(TEXT("Released twice"), Pool->Release(Actor));
+    TestEqual(TEXT("Free after release"), Pool->GetStats(Class).NumFree, 2);
+
+    // Once the pool is empty, Acquire spawns
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        TestNotNull(TEXT("Acquired actor"), Pool->Acquire(Class, FTransform::Identity));
+    }
+
+    const FLuaActorPoolStats Stats = Pool->GetStats(Class);
+    TestEqual(TEXT("Spawned actors"), Stats.NumSpawned, 3);
+    TestEqual(TEXT("Reused actors"), Stats.NumReused, 3);
+    TestEqual(TEXT("Acquire calls"), Stats.NumAcquired, 4);
+    TestEqual(TEXT("Free actors"), Stats.NumFree, 0);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
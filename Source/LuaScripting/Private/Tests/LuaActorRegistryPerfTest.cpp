@@ -0,0 +1,85 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaActorRegistrySubsystem.h"
+#include "EngineUtils.h"
+
+namespace LuaActorRegistryPerfTest
+{
+    // The lookup FindActor made before the registry: every actor's name and label compared
+    AActor* FindActorByScan(UWorld* World, const FString& Name)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            AActor* Actor = *It;
+#if WITH_EDITOR
+            if (Actor->GetName().Equals(Name) || Actor->GetActorLabel().Equals(Name))
+#else
+            if (Actor->GetName().Equals(Name))
+#endif
+            {
+                return Actor;
+            }
+        }
+        return nullptr;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaActorRegistryPerfTest, "LuaScripting.Perf.ActorRegistry",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaActorRegistryPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaActorRegistryPerfTest;
+
+    constexpr int32 NumActors = 10000;
+
+    FLuaTestWorld World;
+    ULuaActorRegistrySubsystem* Registry = World.GetSubsystem<ULuaActorRegistrySubsystem>();
+    if (!TestNotNull(TEXT("Registry subsystem"), Registry))
+    {
+        return false;
+    }
+
+    TArray<AActor*> Actors;
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        Actors.Add(World.SpawnActor());
+    }
+
+    // Actors spread over the world's actor list, so the scan doesn't always stop early
+    TArray<FString> Names;
+    for (int32 Index = 0; Index < NumActors; Index += NumActors / 16)
+    {
+        Names.Add(Actors[Index]->GetName());
+    }
+
+    int32 NumFoundByScan = 0;
+    const double ScanMicroseconds = LuaBenchmark::Time(4, [&]()
+    {
+        for (const FString& Name : Names)
+        {
+            NumFoundByScan += FindActorByScan(World.Get(), Name) != nullptr;
+        }
+    });
+
+    int32 NumFoundInRegistry = 0;
+    const double RegistryMicroseconds = LuaBenchmark::Time(4, [&]()
+    {
+        for (const FString& Name : Names)
+        {
+            NumFoundInRegistry += Registry->FindActorByName(FName(*Name, FNAME_Find), *Name) != nullptr;
+        }
+    });
+
+    TestEqual(TEXT("Actors found by the scan"), NumFoundByScan, Names.Num() * 5);
+    TestEqual(TEXT("Actors found in the registry"), NumFoundInRegistry, Names.Num() * 5);
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d lookups among %d actors, actor scan vs registry"), Names.Num(), NumActors), ScanMicroseconds, RegistryMicroseconds);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
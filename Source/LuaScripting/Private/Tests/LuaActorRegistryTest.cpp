@@ -0,0 +1,57 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaActorRegistrySubsystem.h"
+#include "LuaTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaActorRegistryTest, "LuaScripting.ActorRegistry.Lookups",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FLuaActorRegistryTest::RunTest(const FString& Parameters)
+{
+    FLuaTestWorld World;
+    ULuaActorRegistrySubsystem* Registry = World.GetSubsystem<ULuaActorRegistrySubsystem>();
+    if (!TestNotNull(TEXT("Registry subsystem"), Registry))
+    {
+        return false;
+    }
+
+    const FName Tag(TEXT("LuaRegistryTest"));
+    AActor* Tagged = World.SpawnActor();
+    AActor* Untagged = World.SpawnActor();
+    Registry->AddActorTag(Tagged, Tag);
+
+    // The first lookup builds the index from the actors already in the world
+    TestTrue(TEXT("Index built on first use"), Registry->FindActorByName(Tagged->GetFName()) == Tagged);
+    TestTrue(TEXT("Untagged actor found by name"), Registry->FindActorByName(Untagged->GetFName()) == Untagged);
+    TestTrue(TEXT("Exact name"), Registry->FindActorByName(Untagged->GetFName(), *Untagged->GetName()) == Untagged);
+    TestNull(TEXT("Name differing by case"), Registry->FindActorByName(Untagged->GetFName(), *Untagged->GetName().ToUpper()));
+
+    TArray<AActor*> WithTag;
+    Registry->FindActorsWithTag(Tag, WithTag);
+    TestEqual(TEXT("Actors with the tag"), WithTag.Num(), 1);
+    TestTrue(TEXT("Tagged actor found by tag"), WithTag.Contains(Tagged));
+
+    // Actors spawned after the index was built are added through the world's spawn delegate
+    AActor* Spawned = World.SpawnActor();
+    TestTrue(TEXT("Spawned actor found by name"), Registry->FindActorByName(Spawned->GetFName()) == Spawned);
+
+    TArray<AActor*> OfClass;
+    Registry->FindActorsOfClass(AActor::StaticClass(), false, OfClass);
+    TestTrue(TEXT("Class lookup has every plain actor"), OfClass.Contains(Tagged) && OfClass.Contains(Untagged) && OfClass.Contains(Spawned));
+
+    // Removed tags and destroyed actors are no longer found
+    TestTrue(TEXT("Tag removed"), Registry->RemoveActorTag(Tagged, Tag));
+    WithTag.Reset();
+    Registry->FindActorsWithTag(Tag, WithTag);
+    TestEqual(TEXT("Actors with the removed tag"), WithTag.Num(), 0);
+
+    const FName DestroyedName = Untagged->GetFName();
+    Untagged->Destroy();
+    TestNull(TEXT("Destroyed actor"), Registry->FindActorByName(DestroyedName));
+
+    return true;
+}
+
+#endif
\ No newline at end of file
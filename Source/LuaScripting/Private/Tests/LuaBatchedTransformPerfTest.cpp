@@ -0,0 +1,87 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+
+namespace LuaBatchedTransformPerfTest
+{
+    // One frame of a crowd script, moving and turning every actor one call at a time or in one batch
+    const TCHAR* Script = TEXT(R"(
+        frame = 0
+
+        function setup()
+            locations = UE.Buffer.Float64(#actors * 3)
+            rotations = UE.Buffer.Float64(#actors * 3)
+        end
+
+        function moveEach()
+            frame = frame + 1
+            local location, rotation = UE.Vector(0, 0, 0), UE.Rotator(0, 0, 0)
+            for i = 1, #actors do
+                location:Set(i, frame, 0)
+                rotation:Set(0, frame, 0)
+                actors[i]:SetActorLocation(location)
+                actors[i]:SetActorRotation(rotation)
+            end
+        end
+
+        function moveBatched()
+            frame = frame + 1
+            local locations, rotations = locations, rotations
+            for i = 1, #actors do
+                local base = i * 3
+                locations[base - 2], locations[base - 1], locations[base] = i, frame, 0
+                rotations[base - 1] = frame
+            end
+            UE.Actor.SetTransforms(actors, locations, rotations, nil)
+        end
+
+        function check()
+            local location = actors[#actors]:GetActorLocation()
+            return location.X == #actors and location.Y == frame
+        end
+    )");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaBatchedTransformPerfTest, "LuaScripting.Perf.BatchedTransforms",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaBatchedTransformPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaBatchedTransformPerfTest;
+
+    FLuaTestWorld World;
+    TArray<AActor*> Actors;
+    for (int32 Index = 0; Index < 10000; ++Index)
+    {
+        Actors.Add(World.SpawnMovableActor());
+    }
+
+    for (const int32 NumActors : { 1000, 5000, 10000 })
+    {
+        ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+        FString ErrorMessage;
+        if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+        {
+            AddError(ErrorMessage);
+            return false;
+        }
+        LuaBenchmark::SetGlobalActors(Component, "actors", TArrayView<AActor* const>(Actors.GetData(), NumActors));
+        Component->CallFunction(TEXT("setup"), ErrorMessage);
+
+        const double EachMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("moveEach"), 10);
+        const double BatchedMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("moveBatched"), 10);
+        LuaBenchmark::Report(*this, FString::Printf(TEXT("Frame moving %d actors, per-actor calls vs SetTransforms"), NumActors), EachMicroseconds, BatchedMicroseconds);
+
+        lua_State* L = Component->GetLuaState();
+        lua_getglobal(L, "check");
+        TestTrue(FString::Printf(TEXT("Batched transforms applied to %d actors"), NumActors), lua_pcall(L, 0, 1, 0) == LUA_OK && lua_toboolean(L, -1));
+        lua_pop(L, 1);
+    }
+
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "LuaScriptComponent.h"
+#include "LuaBinding.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+/**
+ * Timing helpers for the performance tests, which run the path an optimization replaced next to the new one
+ * Times depend on the machine, they are reported in the test log rather than checked
+ */
+namespace LuaBenchmark
+{
+    /**
+     * Time a function, after one untimed run that warms up caches
+     * @param NumRuns Number of timed runs
+     * @param Function The function to time
+     * @return Average time of one run in microseconds
+     */
+    inline double Time(int32 NumRuns, TFunctionRef<void()> Function)
+    {
+        Function();
+
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Run = 0; Run < NumRuns; ++Run)
+        {
+            Function();
+        }
+        return (FPlatformTime::Seconds() - Start) * 1000000.0 / FMath::Max(NumRuns, 1);
+    }
+
+    /**
+     * Time a global function of a script
+     * @param Test The test reporting a failed call
+     * @param Component The script component
+     * @param FunctionName Name of the function
+     * @param NumRuns Number of timed calls
+     * @return Average time of one call in microseconds
+     */
+    inline double TimeFunction(FAutomationTestBase& Test, ULuaScriptComponent* Component, const FString& FunctionName, int32 NumRuns)
+    {
+        FString ErrorMessage;
+        bool bSucceeded = true;
+        const double Microseconds = Time(NumRuns, [&]()
+        {
+            bSucceeded &= Component->CallFunction(FunctionName, ErrorMessage);
+        });
+
+        if (!bSucceeded)
+        {
+            Test.AddError(FString::Printf(TEXT("%s: %s"), *FunctionName, *ErrorMessage));
+        }
+        return Microseconds;
+    }
+
+    /**
+     * Set a global of a script to an array of actors
+     * @param Component The script component
+     * @param Name Name of the global
+     * @param Actors The actors
+     */
+    inline void SetGlobalActors(ULuaScriptComponent* Component, const char* Name, TArrayView<AActor* const> Actors)
+    {
+        lua_State* L = Component->GetLuaState();
+        lua_createtable(L, Actors.Num(), 0);
+        for (int32 Index = 0; Index < Actors.Num(); ++Index)
+        {
+            FLuaBinding::PushUObject(L, Actors[Index]);
+            lua_rawseti(L, -2, Index + 1);
+        }
+        lua_setglobal(L, Name);
+    }
+
+    /**
+     * Log the times of the old and the new path
+     * @param Test The test to log to
+     * @param What What was timed
+     * @param OldMicroseconds Time of the old path
+     * @param NewMicroseconds Time of the new path
+     */
+    inline void Report(FAutomationTestBase& Test, const FString& What, double OldMicroseconds, double NewMicroseconds)
+    {
+        Test.AddInfo(FString::Printf(TEXT("%s: %.3f us before, %.3f us after (%.2fx)"), *What, OldMicroseconds, NewMicroseconds,
+            NewMicroseconds > 0.0 ? OldMicroseconds / NewMicroseconds : 0.0));
+    }
+}
+
+#endif
\ No newline at end of file
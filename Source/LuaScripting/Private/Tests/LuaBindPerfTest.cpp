@@ -0,0 +1,109 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaBind.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace LuaBindPerfTest
+{
+    constexpr int32 NumCalls = 100000;
+
+    // Bindings written by hand, the way they were before LuaBind
+    int HandSetActorHiddenInGame(lua_State* L)
+    {
+        if (lua_gettop(L) < 2)
+        {
+            return luaL_error(L, "SetActorHiddenInGame expects an actor and a boolean");
+        }
+
+        AActor* Actor = Cast<AActor>(FLuaBinding::GetUObject(L, 1));
+        if (!Actor)
+        {
+            return luaL_error(L, "SetActorHiddenInGame called on an invalid actor");
+        }
+
+        Actor->SetActorHiddenInGame(lua_toboolean(L, 2) != 0);
+        return 0;
+    }
+
+    int HandGetActorLocation(lua_State* L)
+    {
+        AActor* Actor = Cast<AActor>(FLuaBinding::GetUObject(L, 1));
+        if (!Actor)
+        {
+            return luaL_error(L, "GetActorLocation called on an invalid actor");
+        }
+
+        FLuaValueTypes::PushVector(L, Actor->GetActorLocation());
+        return 1;
+    }
+
+    const TCHAR* Script = TEXT(R"(
+        local N = 100000
+
+        local function run(setHidden, getLocation)
+            local actor = self
+            local sum = 0
+            for i = 1, N do
+                setHidden(actor, i % 2 == 0)
+                sum = sum + getLocation(actor).X
+            end
+            return sum
+        end
+
+        function handWritten()
+            run(hand.SetActorHiddenInGame, hand.GetActorLocation)
+        end
+
+        function generated()
+            run(bound.SetActorHiddenInGame, bound.GetActorLocation)
+        end
+    )");
+
+    void SetBindings(lua_State* L, const char* Name, lua_CFunction SetHidden, lua_CFunction GetLocation)
+    {
+        lua_createtable(L, 0, 2);
+        lua_pushcfunction(L, SetHidden);
+        lua_setfield(L, -2, "SetActorHiddenInGame");
+        lua_pushcfunction(L, GetLocation);
+        lua_setfield(L, -2, "GetActorLocation");
+        lua_setglobal(L, Name);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaBindPerfTest, "LuaScripting.Perf.Bind",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaBindPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaBindPerfTest;
+
+    FLuaTestWorld World;
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnMovableActor(), Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+
+    lua_State* L = Component->GetLuaState();
+    SetBindings(L, "hand", &HandSetActorHiddenInGame, &HandGetActorLocation);
+    SetBindings(L, "bound", LuaBind<&AActor::SetActorHiddenInGame>(), LuaBind<&AActor::GetActorLocation>());
+
+    const double HandMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("handWritten"), 5);
+    const double BoundMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("generated"), 5);
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d SetActorHiddenInGame and GetActorLocation calls, hand-written vs LuaBind"), NumCalls), HandMicroseconds, BoundMicroseconds);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
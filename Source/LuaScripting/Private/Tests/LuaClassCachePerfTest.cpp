@@ -0,0 +1,72 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaClassCache.h"
+#include "Engine/StaticMeshActor.h"
+#include "UObject/UObjectIterator.h"
+
+namespace LuaClassCachePerfTest
+{
+    // The resolution SpawnActor made before the cache: every class in the process compared by name
+    UClass* FindClassByScan(const FString& Name)
+    {
+        for (TObjectIterator<UClass> It; It; ++It)
+        {
+            UClass* Class = *It;
+            if (Class->IsChildOf(AActor::StaticClass()) && Class->GetName().Equals(Name))
+            {
+                return Class;
+            }
+        }
+        return nullptr;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaClassCachePerfTest, "LuaScripting.Perf.ClassCache",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaClassCachePerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaClassCachePerfTest;
+
+    constexpr int32 NumSpawns = 200;
+    const FString ClassName = TEXT("StaticMeshActor");
+
+    FLuaTestWorld World;
+    TArray<AActor*> Spawned;
+
+    // Class lookup and spawn, as SpawnActor runs them for every call
+    auto SpawnWith = [&](TFunctionRef<UClass*()> FindClass)
+    {
+        return LuaBenchmark::Time(NumSpawns, [&]()
+        {
+            if (UClass* Class = FindClass())
+            {
+                Spawned.Add(World.Get()->SpawnActor(Class));
+            }
+        });
+    };
+
+    const double ScanMicroseconds = SpawnWith([&]() { return FindClassByScan(ClassName); });
+    const double CacheMicroseconds = SpawnWith([&]() { return FLuaClassCache::Get().FindClass(*ClassName); });
+
+    TestEqual(TEXT("Actors spawned"), Spawned.Num(), (NumSpawns + 1) * 2);
+    TestTrue(TEXT("Cached class"), FLuaClassCache::Get().FindClass(*ClassName) == AStaticMeshActor::StaticClass());
+    LuaBenchmark::Report(*this, TEXT("SpawnActor, class scan vs class cache"), ScanMicroseconds, CacheMicroseconds);
+
+    // The lookup alone, without the cost of spawning
+    const double ScanLookupMicroseconds = LuaBenchmark::Time(NumSpawns, [&]() { FindClassByScan(ClassName); });
+    const double CacheLookupMicroseconds = LuaBenchmark::Time(NumSpawns, [&]() { FLuaClassCache::Get().FindClass(*ClassName); });
+    LuaBenchmark::Report(*this, TEXT("Class lookup, class scan vs class cache"), ScanLookupMicroseconds, CacheLookupMicroseconds);
+
+    for (AActor* Actor : Spawned)
+    {
+        Actor->Destroy();
+    }
+    return true;
+}
+
+#endif
\ No newline at end of file
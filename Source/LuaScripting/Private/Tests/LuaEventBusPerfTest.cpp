@@ -0,0 +1,130 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace LuaEventBusPerfTest
+{
+    constexpr int32 NumTriggers = 100000;
+
+    // UE.Event.Trigger before the event bus: handlers kept in UE.Event._events and looked up by name on every trigger
+    int OldTrigger(lua_State* L)
+    {
+        const char* EventName = luaL_checkstring(L, 1);
+
+        lua_getglobal(L, "UE");
+        lua_getfield(L, -1, "OldEvent");
+        lua_getfield(L, -1, "_events");
+        lua_getfield(L, -1, EventName);
+
+        if (lua_istable(L, -1))
+        {
+            const int NumArgs = lua_gettop(L) - 4;
+            const int NumHandlers = (int)lua_rawlen(L, -1);
+            for (int Handler = 1; Handler <= NumHandlers; ++Handler)
+            {
+                lua_rawgeti(L, -1, Handler);
+                if (lua_isfunction(L, -1))
+                {
+                    for (int Arg = 2; Arg <= NumArgs + 1; ++Arg)
+                    {
+                        lua_pushvalue(L, Arg);
+                    }
+                    lua_call(L, NumArgs, 0);
+                }
+                else
+                {
+                    lua_pop(L, 1);
+                }
+            }
+        }
+
+        lua_pop(L, 4);
+        return 0;
+    }
+
+    const TCHAR* Script = TEXT(R"(
+        local N = 100000
+        hits = 0
+        local function onHit(amount)
+            hits = hits + amount
+        end
+
+        UE.OldEvent = { _events = { hit = { onHit, onHit, onHit, onHit } } }
+        for i = 1, 4 do
+            UE.Event.Register("hit", onHit)
+        end
+
+        function triggerOld()
+            local trigger = UE.OldEvent.Trigger
+            for i = 1, N do
+                trigger("hit", 1)
+            end
+        end
+
+        function triggerNew()
+            local trigger = UE.Event.Trigger
+            for i = 1, N do
+                trigger("hit", 1)
+            end
+        end
+    )");
+
+    int32 TakeHits(ULuaScriptComponent* Component)
+    {
+        lua_State* L = Component->GetLuaState();
+        lua_getglobal(L, "hits");
+        const int32 Hits = (int32)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        lua_pushinteger(L, 0);
+        lua_setglobal(L, "hits");
+        return Hits;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaEventBusPerfTest, "LuaScripting.Perf.EventBus",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaEventBusPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaEventBusPerfTest;
+
+    FLuaTestWorld World;
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+
+    lua_State* L = Component->GetLuaState();
+    lua_getglobal(L, "UE");
+    lua_getfield(L, -1, "OldEvent");
+    lua_pushcfunction(L, &OldTrigger);
+    lua_setfield(L, -2, "Trigger");
+    lua_pop(L, 2);
+
+    const double OldMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("triggerOld"), 5);
+    const int32 OldHits = TakeHits(Component);
+    const double NewMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("triggerNew"), 5);
+    const int32 NewHits = TakeHits(Component);
+
+    TestEqual(TEXT("Handlers called by the old trigger"), OldHits, NumTriggers * 4 * 6);
+    TestEqual(TEXT("Handlers called by the event bus"), NewHits, NumTriggers * 4 * 6);
+    AddInfo(FString::Printf(TEXT("Triggers per second with 4 handlers: %.0f before, %.0f after"),
+        NumTriggers / (OldMicroseconds / 1000000.0), NumTriggers / (NewMicroseconds / 1000000.0)));
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d triggers, Lua table registry vs event bus"), NumTriggers), OldMicroseconds, NewMicroseconds);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
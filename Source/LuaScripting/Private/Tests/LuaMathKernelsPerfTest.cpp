@@ -0,0 +1,117 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+
+namespace LuaMathKernelsPerfTest
+{
+    constexpr int32 NumVectors = 10000;
+
+    // Each kernel next to the loop a script would write without it
+    const TCHAR* Script = TEXT(R"(
+        local N = 10000
+        a, b, out, dist = {}, {}, {}, {}
+        for i = 1, N * 3 do
+            a[i] = i
+            b[i] = N * 3 - i
+            out[i] = 0
+        end
+        bufA = UE.Buffer.New("float32", a)
+        bufB = UE.Buffer.New("float32", b)
+        bufOut = UE.Buffer.Float32(N * 3)
+        bufDist = UE.Buffer.Float32(N)
+        point = UE.Vector(1, 2, 3)
+
+        function lerpLua()
+            local a, b, out = a, b, out
+            for i = 1, #a do
+                out[i] = a[i] + (b[i] - a[i]) * 0.5
+            end
+        end
+
+        function lerpKernel()
+            UE.Math.LerpVectors(bufA, bufB, 0.5, bufOut)
+        end
+
+        function normalizeLua()
+            local a, out, sqrt = a, out, math.sqrt
+            for i = 1, #a, 3 do
+                local x, y, z = a[i], a[i + 1], a[i + 2]
+                local size = sqrt(x * x + y * y + z * z)
+                if size > 1e-8 then
+                    out[i], out[i + 1], out[i + 2] = x / size, y / size, z / size
+                else
+                    out[i], out[i + 1], out[i + 2] = 0, 0, 0
+                end
+            end
+        end
+
+        function normalizeKernel()
+            UE.Math.NormalizeVectors(bufA, bufOut)
+        end
+
+        function distancesLua()
+            local a, dist, sqrt = a, dist, math.sqrt
+            local px, py, pz = point.X, point.Y, point.Z
+            local n = 0
+            for i = 1, #a, 3 do
+                local dx, dy, dz = a[i] - px, a[i + 1] - py, a[i + 2] - pz
+                n = n + 1
+                dist[n] = sqrt(dx * dx + dy * dy + dz * dz)
+            end
+        end
+
+        function distancesKernel()
+            UE.Math.DistancesToPoint(bufA, point, bufDist)
+        end
+
+        function check()
+            lerpLua()
+            lerpKernel()
+            distancesLua()
+            distancesKernel()
+            for i = 1, #out, 997 do
+                assert(math.abs(bufOut[i] - out[i]) < 1e-2, "lerp")
+            end
+            for i = 1, #dist, 997 do
+                assert(math.abs(bufDist[i] - dist[i]) < 1e-2 * dist[i] + 1e-2, "distance")
+            end
+        end
+    )");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaMathKernelsPerfTest, "LuaScripting.Perf.MathKernels",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaMathKernelsPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaMathKernelsPerfTest;
+
+    FLuaTestWorld World;
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+
+    if (!Component->CallFunction(TEXT("check"), ErrorMessage))
+    {
+        AddError(FString::Printf(TEXT("Kernels and Lua loops disagree: %s"), *ErrorMessage));
+        return false;
+    }
+
+    for (const TCHAR* Kernel : { TEXT("lerp"), TEXT("normalize"), TEXT("distances") })
+    {
+        const double LuaMicroseconds = LuaBenchmark::TimeFunction(*this, Component, FString(Kernel) + TEXT("Lua"), 20);
+        const double KernelMicroseconds = LuaBenchmark::TimeFunction(*this, Component, FString(Kernel) + TEXT("Kernel"), 20);
+        LuaBenchmark::Report(*this, FString::Printf(TEXT("%s of %d vectors, Lua loop vs kernel"), Kernel, NumVectors), LuaMicroseconds, KernelMicroseconds);
+    }
+
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaBinding.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaObjectHandlePerfTest, "LuaScripting.Perf.ObjectHandle",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaObjectHandlePerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumAccesses = 1000000;
+
+    FLuaTestWorld World;
+    AActor* Actor = World.SpawnActor();
+
+    // A script's state, with the object metatable registered
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), TEXT(""));
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    lua_State* L = Component->GetLuaState();
+
+    // Userdata holding the raw pointer, as objects were pushed before handles
+    *static_cast<UObject**>(lua_newuserdatauv(L, sizeof(UObject*), 0)) = Actor;
+    const int RawIndex = lua_gettop(L);
+    FLuaBinding::PushUObject(L, Actor);
+    const int HandleIndex = lua_gettop(L);
+
+    // Summed so the accesses can't be optimized away
+    UPTRINT RawSum = 0;
+    const double RawMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Access = 0; Access < NumAccesses; ++Access)
+        {
+            RawSum += (UPTRINT)static_cast<UObject*>(*static_cast<void**>(lua_touserdata(L, RawIndex)));
+        }
+    });
+
+    UPTRINT HandleSum = 0;
+    const double HandleMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Access = 0; Access < NumAccesses; ++Access)
+        {
+            HandleSum += (UPTRINT)FLuaBinding::GetUObject(L, HandleIndex);
+        }
+    });
+
+    TestEqual(TEXT("Both paths resolve the actor"), HandleSum, RawSum);
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d object accesses, raw pointer vs validated handle"), NumAccesses), RawMicroseconds, HandleMicroseconds);
+
+    // The handle's extra cost buys a stale reference reading as nil instead of crashing
+    Actor->Destroy();
+    TestNull(TEXT("Destroyed actor"), FLuaBinding::GetUObject(L, HandleIndex));
+
+    lua_pop(L, 2);
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+namespace LuaOutValuePerfTest
+{
+    constexpr int32 NumActors = 1000;
+
+    // A transform-follow script: every frame, each follower reads its target's transform
+    const TCHAR* Script = TEXT(R"(
+        local location, rotation, scale = UE.Vector(0, 0, 0), UE.Rotator(0, 0, 0), UE.Vector(0, 0, 0)
+        sum = 0
+
+        function followNew()
+            for i = 1, #actors do
+                local target = actors[i]
+                local l, r, s = target:GetActorLocation(), target:GetActorRotation(), target:GetActorScale3D()
+                sum = sum + l.X + r.Yaw + s.Z
+            end
+        end
+
+        function followOut()
+            for i = 1, #actors do
+                local target = actors[i]
+                target:GetActorLocation(location)
+                target:GetActorRotation(rotation)
+                target:GetActorScale3D(scale)
+                sum = sum + location.X + rotation.Yaw + scale.Z
+            end
+        end
+    )");
+
+    struct FFrameCost
+    {
+        double Microseconds = 0.0;
+        double AllocatedKilobytes = 0.0;
+        double CollectMicroseconds = 0.0;
+    };
+
+    // Cost of one frame, and of collecting the garbage it left
+    FFrameCost MeasureFrame(FAutomationTestBase& Test, ULuaScriptComponent* Component, const FString& FunctionName)
+    {
+        constexpr int32 NumFrames = 20;
+        lua_State* L = Component->GetLuaState();
+        FFrameCost Cost;
+
+        lua_gc(L, LUA_GCCOLLECT);
+        lua_gc(L, LUA_GCSTOP);
+        const double KilobytesBefore = lua_gc(L, LUA_GCCOUNT) + lua_gc(L, LUA_GCCOUNTB) / 1024.0;
+        Cost.Microseconds = LuaBenchmark::TimeFunction(Test, Component, FunctionName, NumFrames);
+        const double KilobytesAfter = lua_gc(L, LUA_GCCOUNT) + lua_gc(L, LUA_GCCOUNTB) / 1024.0;
+        Cost.AllocatedKilobytes = (KilobytesAfter - KilobytesBefore) / (NumFrames + 1);
+
+        // Timed once, a second collection would find nothing left
+        const double CollectStart = FPlatformTime::Seconds();
+        lua_gc(L, LUA_GCCOLLECT);
+        Cost.CollectMicroseconds = (FPlatformTime::Seconds() - CollectStart) * 1000000.0;
+        lua_gc(L, LUA_GCRESTART);
+        return Cost;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaOutValuePerfTest, "LuaScripting.Perf.OutValues",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaOutValuePerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaOutValuePerfTest;
+
+    FLuaTestWorld World;
+    TArray<AActor*> Actors;
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        Actors.Add(World.SpawnMovableActor(FVector(Index, 0.0, 0.0)));
+    }
+
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    LuaBenchmark::SetGlobalActors(Component, "actors", Actors);
+
+    const FFrameCost New = MeasureFrame(*this, Component, TEXT("followNew"));
+    const FFrameCost Out = MeasureFrame(*this, Component, TEXT("followOut"));
+
+    // The collection after the run gathers the garbage of every frame, the first run's included
+    AddInfo(FString::Printf(TEXT("Lua memory allocated per frame: %.1f KB with new values, %.1f KB with out values"), New.AllocatedKilobytes, Out.AllocatedKilobytes));
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("Frame reading %d transforms, new values vs out values"), NumActors), New.Microseconds, Out.Microseconds);
+    LuaBenchmark::Report(*this, TEXT("Full collection after 21 frames, new values vs out values"), New.CollectMicroseconds, Out.CollectMicroseconds);
+    TestTrue(TEXT("Out values allocate less"), Out.AllocatedKilobytes < New.AllocatedKilobytes);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
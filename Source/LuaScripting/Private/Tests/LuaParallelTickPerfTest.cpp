@@ -0,0 +1,90 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaTickSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeExit.h"
+#include "Async/TaskGraphInterfaces.h"
+
+namespace LuaParallelTickPerfTest
+{
+    constexpr int32 NumActors = 5000;
+
+    // Some script work per tick, then a recorded move
+    const TCHAR* Script = TEXT(R"(
+        local location = UE.Vector(0, 0, 0)
+        local phase = 0
+
+        function tick(deltaTime)
+            self:GetActorLocation(location)
+            local offset = 0
+            for i = 1, 200 do
+                offset = offset + math.sin(phase + i * 0.01)
+            end
+            phase = phase + deltaTime
+            location:Set(location.X, location.Y, offset * 0.001)
+            self:SetActorLocation(location)
+        end
+    )");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaParallelTickPerfTest, "LuaScripting.Perf.ParallelTick",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaParallelTickPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaParallelTickPerfTest;
+
+    IConsoleVariable* ParallelCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("lua.Tick.Parallel"));
+    IConsoleVariable* MaxTasksCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("lua.Tick.ParallelMaxTasks"));
+    if (!TestNotNull(TEXT("lua.Tick.Parallel"), ParallelCVar) || !TestNotNull(TEXT("lua.Tick.ParallelMaxTasks"), MaxTasksCVar))
+    {
+        return false;
+    }
+    const bool bWasParallel = ParallelCVar->GetBool();
+    const int32 OldMaxTasks = MaxTasksCVar->GetInt();
+    ON_SCOPE_EXIT
+    {
+        ParallelCVar->Set(bWasParallel);
+        MaxTasksCVar->Set(OldMaxTasks);
+    };
+
+    FLuaTestWorld World;
+    ULuaTickSubsystem* TickSubsystem = World.GetSubsystem<ULuaTickSubsystem>();
+    if (!TestNotNull(TEXT("Tick subsystem"), TickSubsystem))
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnMovableActor(FVector(Index * 100.0, 0.0, 0.0)), Script);
+        Component->bTickInParallel = true;
+        FString ErrorMessage;
+        if (!Component->ExecuteScript(ErrorMessage))
+        {
+            AddError(ErrorMessage);
+            return false;
+        }
+    }
+
+    ParallelCVar->Set(false);
+    const double SerialMicroseconds = LuaBenchmark::Time(10, [TickSubsystem]() { TickSubsystem->Tick(0.016f); });
+
+    // The task limit bounds the number of cores ticking scripts at once
+    ParallelCVar->Set(true);
+    AddInfo(FString::Printf(TEXT("Task graph worker threads: %d"), FTaskGraphInterface::Get().GetNumWorkerThreads()));
+    for (const int32 NumTasks : { 1, 2, 4, 8, 16 })
+    {
+        MaxTasksCVar->Set(NumTasks);
+        const double ParallelMicroseconds = LuaBenchmark::Time(10, [TickSubsystem]() { TickSubsystem->Tick(0.016f); });
+        LuaBenchmark::Report(*this, FString::Printf(TEXT("Tick of %d scripts, game thread vs %d parallel tasks"), NumActors, NumTasks), SerialMicroseconds, ParallelMicroseconds);
+    }
+
+    return true;
+}
+
+#endif
\ No newline at end of file
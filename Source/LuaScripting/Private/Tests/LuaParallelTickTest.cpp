@@ -0,0 +1,90 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaScriptComponent.h"
+#include "LuaTickSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeExit.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+namespace LuaParallelTickTest
+{
+    // Recorded calls are applied in order; reads see the world as it was before the parallel tick
+    const TCHAR* Script = TEXT(R"(
+        function tick(deltaTime)
+            self:AddTag("LuaParallelTestRemoved")
+            self:RemoveTag("LuaParallelTestRemoved")
+            self:AddTag("LuaParallelTestAdded")
+            sawAddedTag = self:HasTag("LuaParallelTestAdded")
+            spawnFailed = not pcall(UE.Actor.SpawnActor, "Actor")
+        end
+    )");
+
+    bool GetGlobalBool(ULuaScriptComponent* Component, const char* Name)
+    {
+        lua_State* L = Component->GetLuaState();
+        lua_getglobal(L, Name);
+        const bool bValue = lua_toboolean(L, -1) != 0;
+        lua_pop(L, 1);
+        return bValue;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaParallelTickTest, "LuaScripting.TickSubsystem.ParallelTick",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FLuaParallelTickTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaParallelTickTest;
+
+    IConsoleVariable* ParallelCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("lua.Tick.Parallel"));
+    if (!TestNotNull(TEXT("lua.Tick.Parallel"), ParallelCVar))
+    {
+        return false;
+    }
+    const bool bWasParallel = ParallelCVar->GetBool();
+    ParallelCVar->Set(true);
+    ON_SCOPE_EXIT { ParallelCVar->Set(bWasParallel); };
+
+    FLuaTestWorld World;
+    ULuaTickSubsystem* TickSubsystem = World.GetSubsystem<ULuaTickSubsystem>();
+
+    // Several scripts so the parallel tick has more than one task
+    TArray<AActor*> Actors;
+    TArray<ULuaScriptComponent*> Components;
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        AActor* Actor = World.SpawnActor();
+        ULuaScriptComponent* Component = FLuaTestWorld::AddScript(Actor, Script);
+        Component->bTickInParallel = true;
+
+        FString ErrorMessage;
+        if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+        {
+            AddError(ErrorMessage);
+            return false;
+        }
+        Actors.Add(Actor);
+        Components.Add(Component);
+    }
+
+    TickSubsystem->Tick(0.02f);
+
+    for (int32 Index = 0; Index < Actors.Num(); ++Index)
+    {
+        TestFalse(TEXT("Recorded tag visible to the script during the parallel tick"), GetGlobalBool(Components[Index], "sawAddedTag"));
+        TestTrue(TEXT("Spawning from a parallel tick raised an error"), GetGlobalBool(Components[Index], "spawnFailed"));
+        TestTrue(TEXT("Recorded AddTag applied"), Actors[Index]->ActorHasTag(TEXT("LuaParallelTestAdded")));
+        TestFalse(TEXT("Recorded calls applied in order"), Actors[Index]->ActorHasTag(TEXT("LuaParallelTestRemoved")));
+    }
+
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaSpatialIndexSubsystem.h"
+
+namespace LuaSpatialIndexPerfTest
+{
+    constexpr int32 NumActors = 5000;
+    constexpr int32 NumQueries = 100;
+
+    // Radius queries around query points, scanning every actor from the script or asking the spatial index
+    const TCHAR* Script = TEXT(R"(
+        local radius = 1000
+        local location = UE.Vector(0, 0, 0)
+        local results = {}
+
+        local points = {}
+        for i = 1, 100 do
+            points[i] = UE.Vector((i * 7919) % 20000 - 10000, (i * 104729) % 20000 - 10000, 0)
+        end
+
+        function bruteForce()
+            found = 0
+            local radiusSquared = radius * radius
+            for q = 1, #points do
+                local center = points[q]
+                local n = 0
+                for i = 1, #actors do
+                    actors[i]:GetActorLocation(location)
+                    local dx, dy, dz = location.X - center.X, location.Y - center.Y, location.Z - center.Z
+                    if dx * dx + dy * dy + dz * dz <= radiusSquared then
+                        n = n + 1
+                        results[n] = actors[i]
+                    end
+                end
+                found = found + n
+            end
+        end
+
+        function indexed()
+            found = 0
+            for q = 1, #points do
+                found = found + #UE.World.QueryRadius(points[q], radius, results)
+            end
+        end
+    )");
+
+    int32 GetFound(ULuaScriptComponent* Component)
+    {
+        lua_State* L = Component->GetLuaState();
+        lua_getglobal(L, "found");
+        const int32 Found = (int32)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        return Found;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaSpatialIndexPerfTest, "LuaScripting.Perf.SpatialIndex",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaSpatialIndexPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaSpatialIndexPerfTest;
+
+    FLuaTestWorld World;
+    ULuaSpatialIndexSubsystem* SpatialIndex = World.GetSubsystem<ULuaSpatialIndexSubsystem>();
+    if (!TestNotNull(TEXT("Spatial index subsystem"), SpatialIndex))
+    {
+        return false;
+    }
+
+    // Actors spread over a 20km square
+    FRandomStream Random(1234);
+    TArray<AActor*> Actors;
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        AActor* Actor = World.SpawnMovableActor(FVector(Random.FRandRange(-10000.0, 10000.0), Random.FRandRange(-10000.0, 10000.0), 0.0));
+        SpatialIndex->TrackActor(Actor);
+        Actors.Add(Actor);
+    }
+
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    LuaBenchmark::SetGlobalActors(Component, "actors", Actors);
+
+    const double BruteForceMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("bruteForce"), 5);
+    const int32 FoundByBruteForce = GetFound(Component);
+    const double IndexedMicroseconds = LuaBenchmark::TimeFunction(*this, Component, TEXT("indexed"), 5);
+    const int32 FoundByIndex = GetFound(Component);
+
+    TestEqual(TEXT("Actors found by both"), FoundByIndex, FoundByBruteForce);
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d radius queries among %d actors, Lua scan vs spatial index"), NumQueries, NumActors), BruteForceMicroseconds, IndexedMicroseconds);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
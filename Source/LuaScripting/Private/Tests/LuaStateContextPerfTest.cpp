@@ -0,0 +1,87 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaBinding.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+namespace LuaStateContextPerfTest
+{
+    // The lookup bindings made before the context existed: the "self" global, then the "component" global
+    UWorld* GetWorldFromGlobals(lua_State* L, int32& OutNumGlobalLookups)
+    {
+        ++OutNumGlobalLookups;
+        lua_getglobal(L, "self");
+        AActor* SelfActor = Cast<AActor>(FLuaBinding::GetUObject(L, -1));
+        lua_pop(L, 1);
+        if (SelfActor)
+        {
+            return SelfActor->GetWorld();
+        }
+
+        ++OutNumGlobalLookups;
+        lua_getglobal(L, "component");
+        UActorComponent* Component = Cast<UActorComponent>(FLuaBinding::GetUObject(L, -1));
+        lua_pop(L, 1);
+        return Component ? Component->GetWorld() : nullptr;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaStateContextPerfTest, "LuaScripting.Perf.StateContext",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaStateContextPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaStateContextPerfTest;
+
+    constexpr int32 NumCalls = 1000000;
+
+    FLuaTestWorld World;
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), TEXT(""));
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    lua_State* L = Component->GetLuaState();
+
+    int32 NumGlobalLookups = 0;
+    int32 NumFromGlobals = 0;
+    const double GlobalsMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Call = 0; Call < NumCalls; ++Call)
+        {
+            NumFromGlobals += GetWorldFromGlobals(L, NumGlobalLookups) == World.Get();
+        }
+    });
+
+    int32 NumFromContext = 0;
+    const double ContextMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Call = 0; Call < NumCalls; ++Call)
+        {
+            NumFromContext += FLuaBinding::GetWorld(L) == World.Get();
+        }
+    });
+
+    TestEqual(TEXT("Worlds found through the globals"), NumFromGlobals, NumCalls * 2);
+    TestEqual(TEXT("Worlds found through the context"), NumFromContext, NumCalls * 2);
+    AddInfo(FString::Printf(TEXT("Global lookups for %d GetWorld calls: %d before, 0 after"), NumCalls * 2, NumGlobalLookups));
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d GetWorld calls, globals vs state context"), NumCalls), GlobalsMicroseconds, ContextMicroseconds);
+
+    // Scripts reassigning self no longer lose their world
+    lua_pushnil(L);
+    lua_setglobal(L, "self");
+    TestTrue(TEXT("World with self reassigned"), FLuaBinding::GetWorld(L) == World.Get());
+
+    return true;
+}
+
+#endif
\ No newline at end of file
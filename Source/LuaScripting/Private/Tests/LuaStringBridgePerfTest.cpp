@@ -0,0 +1,77 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+#include "LuaStringBridge.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaStringBridgePerfTest, "LuaScripting.Perf.StringBridge",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaStringBridgePerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumConversions = 100000;
+
+    FLuaTestWorld World;
+    AActor* Actor = World.SpawnActor();
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(Actor, TEXT(""));
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    lua_State* L = Component->GetLuaState();
+    lua_pushstring(L, "LuaStringBridgePerfTest");
+    const int TagIndex = lua_gettop(L);
+    const FName Tag(TEXT("LuaStringBridgePerfTest"));
+
+    // Lua string to FName, as HasTag, AddTag and RemoveTag read their tag
+    int32 NumMatched = 0;
+    const double TranscodedNameMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Conversion = 0; Conversion < NumConversions; ++Conversion)
+        {
+            NumMatched += FName(UTF8_TO_TCHAR(lua_tostring(L, TagIndex))) == Tag;
+        }
+    });
+    const double CachedNameMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Conversion = 0; Conversion < NumConversions; ++Conversion)
+        {
+            NumMatched += FLuaStringBridge::ToName(L, TagIndex) == Tag;
+        }
+    });
+    TestEqual(TEXT("Names converted"), NumMatched, NumConversions * 4);
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d Lua string to FName conversions, transcoded vs cached"), NumConversions), TranscodedNameMicroseconds, CachedNameMicroseconds);
+
+    // FName to Lua string, as GetName and GetClass return names
+    const double TranscodedStringMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Conversion = 0; Conversion < NumConversions; ++Conversion)
+        {
+            lua_pushstring(L, TCHAR_TO_UTF8(*Actor->GetName()));
+            lua_pop(L, 1);
+        }
+    });
+    const double CachedStringMicroseconds = LuaBenchmark::Time(1, [&]()
+    {
+        for (int32 Conversion = 0; Conversion < NumConversions; ++Conversion)
+        {
+            FLuaStringBridge::PushName(L, Actor->GetFName());
+            lua_pop(L, 1);
+        }
+    });
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("%d FName to Lua string conversions, transcoded vs cached"), NumConversions), TranscodedStringMicroseconds, CachedStringMicroseconds);
+
+    lua_pop(L, 1);
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaScriptComponent.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace LuaStringBridgeTest
+{
+    // Wraps a state's allocator and counts the allocations and reallocations that grow a block
+    struct FAllocationCounter
+    {
+        lua_Alloc Allocator = nullptr;
+        void* AllocatorData = nullptr;
+        int32 NumAllocations = 0;
+
+        static void* Allocate(void* UserData, void* Block, size_t OldSize, size_t NewSize)
+        {
+            FAllocationCounter* Counter = static_cast<FAllocationCounter*>(UserData);
+
+            // Without a block, OldSize holds the type of the object being created
+            if (NewSize > 0 && (!Block || NewSize > OldSize))
+            {
+                ++Counter->NumAllocations;
+            }
+            return Counter->Allocator(Counter->AllocatorData, Block, OldSize, NewSize);
+        }
+    };
+
+    // Installed as GMalloc around the measured runs, counts the C++ allocations made by one thread; the other
+    // threads keep allocating through it unaffected
+    class FMallocCounter : public FMalloc
+    {
+    public:
+        FMalloc* Inner = nullptr;
+        uint32 ThreadId = 0;
+        int32 NumAllocations = 0;
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                CountAllocation();
+            }
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                CountAllocation();
+            }
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        void CountAllocation()
+        {
+            if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+            {
+                ++NumAllocations;
+            }
+        }
+    };
+
+    const TCHAR* Script = TEXT(R"(
+        function run()
+            local name, hasTag
+            for i = 1, 100 do
+                name = self:GetName()
+                hasTag = self:HasTag("LuaStringBridgeTest")
+            end
+            lastName = name
+            lastHasTag = hasTag
+        end
+    )");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaStringBridgeAllocationTest, "LuaScripting.StringBridge.SteadyStateAllocations",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FLuaStringBridgeAllocationTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaStringBridgeTest;
+
+    FLuaTestWorld World;
+    AActor* Actor = World.SpawnActor();
+    Actor->Tags.Add(TEXT("LuaStringBridgeTest"));
+
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(Actor, Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+    lua_State* L = Component->GetLuaState();
+
+    // The collector would shrink the state's call stack between runs, which is not what this test measures
+    lua_gc(L, LUA_GCSTOP);
+
+    // The first run fills the name caches
+    TestTrue(TEXT("Warm-up call"), Component->CallFunction(TEXT("run"), ErrorMessage));
+
+    const FString FunctionName = TEXT("run");
+
+    FAllocationCounter Counter;
+    Counter.Allocator = lua_getallocf(L, &Counter.AllocatorData);
+    lua_setallocf(L, &FAllocationCounter::Allocate, &Counter);
+
+    // Never freed, other threads may still be calling into it after GMalloc is restored
+    static FMallocCounter* MallocCounter = new FMallocCounter();
+    MallocCounter->Inner = GMalloc;
+    MallocCounter->ThreadId = FPlatformTLS::GetCurrentThreadId();
+    MallocCounter->NumAllocations = 0;
+    GMalloc = MallocCounter;
+
+    for (int32 Run = 0; Run < 10; ++Run)
+    {
+        Component->CallFunction(FunctionName, ErrorMessage);
+    }
+
+    GMalloc = MallocCounter->Inner;
+    const int32 NumMallocs = MallocCounter->NumAllocations;
+
+    lua_setallocf(L, Counter.Allocator, Counter.AllocatorData);
+    lua_gc(L, LUA_GCRESTART);
+
+    TestEqual(TEXT("Lua allocations by GetName, HasTag and CallFunction in steady state"), Counter.NumAllocations, 0);
+    TestEqual(TEXT("C++ allocations by GetName, HasTag and CallFunction in steady state"), NumMallocs, 0);
+
+    // The cached results must still be the right ones
+    lua_getglobal(L, "lastName");
+    const char* Name = lua_tostring(L, -1);
+    TestEqual(TEXT("GetName"), FString(UTF8_TO_TCHAR(Name ? Name : "")), Actor->GetName());
+    lua_getglobal(L, "lastHasTag");
+    TestTrue(TEXT("HasTag"), lua_toboolean(L, -1) != 0);
+    lua_pop(L, 2);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/WorldSettings.h"
+#include "Components/SceneComponent.h"
+#include "LuaScriptComponent.h"
+
+/**
+ * Game world for automation tests, with its world subsystems initialized and play begun
+ * The world is destroyed when the helper goes out of scope
+ */
+class FLuaTestWorld
+{
+public:
+    FLuaTestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+
+        // Without a game mode nothing starts play, actors must begin and end play like in a game
+        if (!World->HasBegunPlay())
+        {
+            World->GetWorldSettings()->NotifyBeginPlay();
+        }
+    }
+
+    ~FLuaTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    UWorld* Get() const { return World; }
+
+    template<typename T>
+    T* GetSubsystem() const { return World->GetSubsystem<T>(); }
+
+    /** Spawn a plain actor */
+    AActor* SpawnActor() const
+    {
+        return World->SpawnActor<AActor>();
+    }
+
+    /**
+     * Spawn an actor with a movable scene root, for tests that move actors
+     * @param Location Where to place the actor
+     * @return The actor
+     */
+    AActor* SpawnMovableActor(const FVector& Location = FVector::ZeroVector) const
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        USceneComponent* Root = NewObject<USceneComponent>(Actor);
+        Actor->SetRootComponent(Root);
+        Root->RegisterComponent();
+        Actor->SetActorLocation(Location);
+        return Actor;
+    }
+
+    /**
+     * Add a script component to an actor without running the script, so tests can configure it first
+     * @param Actor The actor
+     * @param Script The script content
+     * @return The registered component
+     */
+    static ULuaScriptComponent* AddScript(AActor* Actor, const TCHAR* Script)
+    {
+        ULuaScriptComponent* Component = NewObject<ULuaScriptComponent>(Actor);
+        Component->bAutoRun = false;
+        Component->ScriptContent = Script;
+        Component->RegisterComponent();
+        return Component;
+    }
+
+private:
+    UWorld* World;
+};
+
+#endif
\ No newline at end of file
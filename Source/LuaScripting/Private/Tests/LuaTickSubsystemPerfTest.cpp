@@ -0,0 +1,79 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaBenchmark.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+namespace LuaTickSubsystemPerfTest
+{
+    constexpr int32 NumComponents = 10000;
+    constexpr int32 NumFrames = 10;
+
+    const TCHAR* TickingScript = TEXT(R"(
+        ticks = 0
+        function tick(deltaTime)
+            ticks = ticks + 1
+        end
+    )");
+
+    const TCHAR* IdleScript = TEXT(R"(
+        ticks = 0
+    )");
+
+    /**
+     * Time world frames with scripts ticked through their own tick functions or by the tick subsystem
+     * @return Average frame time in microseconds, or a negative time if the scripts did not tick
+     */
+    double TimeFrames(FAutomationTestBase& Test, const TCHAR* Script, bool bUseBatchedTick, bool bExpectTicks)
+    {
+        FLuaTestWorld World;
+        ULuaScriptComponent* First = nullptr;
+        for (int32 Index = 0; Index < NumComponents; ++Index)
+        {
+            ULuaScriptComponent* Component = FLuaTestWorld::AddScript(World.SpawnActor(), Script);
+            Component->bUseBatchedTick = bUseBatchedTick;
+            FString ErrorMessage;
+            if (!Component->ExecuteScript(ErrorMessage))
+            {
+                Test.AddError(ErrorMessage);
+                return -1.0;
+            }
+            First = First ? First : Component;
+        }
+
+        const double Microseconds = LuaBenchmark::Time(NumFrames, [&]()
+        {
+            World.Get()->Tick(LEVELTICK_All, 0.016f);
+        });
+
+        lua_State* L = First->GetLuaState();
+        lua_getglobal(L, "ticks");
+        const int32 Ticks = (int32)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        Test.TestEqual(FString::Printf(TEXT("Ticks with bUseBatchedTick %d"), bUseBatchedTick), Ticks, bExpectTicks ? NumFrames + 1 : 0);
+        return Microseconds;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaTickSubsystemPerfTest, "LuaScripting.Perf.TickSubsystem",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLuaTickSubsystemPerfTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaTickSubsystemPerfTest;
+
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("Frame with %d ticking scripts, component tick functions vs tick subsystem"), NumComponents),
+        TimeFrames(*this, TickingScript, false, true), TimeFrames(*this, TickingScript, true, true));
+    LuaBenchmark::Report(*this, FString::Printf(TEXT("Frame with %d scripts without tick, component tick functions vs tick subsystem"), NumComponents),
+        TimeFrames(*this, IdleScript, false, false), TimeFrames(*this, IdleScript, true, false));
+
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LuaTestWorld.h"
+#include "LuaScriptComponent.h"
+#include "LuaTickSubsystem.h"
+#include "LuaActorPoolSubsystem.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+namespace LuaTickSubsystemTest
+{
+    const TCHAR* Script = TEXT(R"(
+        ticks = 0
+        function tick(deltaTime)
+            ticks = ticks + 1
+        end
+    )");
+
+    int32 GetTicks(ULuaScriptComponent* Component)
+    {
+        lua_State* L = Component->GetLuaState();
+        lua_getglobal(L, "ticks");
+        const int32 Ticks = (int32)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        return Ticks;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLuaTickSubsystemTest, "LuaScripting.TickSubsystem.BatchedTick",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FLuaTickSubsystemTest::RunTest(const FString& Parameters)
+{
+    using namespace LuaTickSubsystemTest;
+
+    FLuaTestWorld World;
+    ULuaTickSubsystem* TickSubsystem = World.GetSubsystem<ULuaTickSubsystem>();
+    ULuaActorPoolSubsystem* Pool = World.GetSubsystem<ULuaActorPoolSubsystem>();
+    if (!TestNotNull(TEXT("Tick subsystem"), TickSubsystem) || !TestNotNull(TEXT("Pool subsystem"), Pool))
+    {
+        return false;
+    }
+
+    AActor* Actor = World.SpawnActor();
+    ULuaScriptComponent* Component = FLuaTestWorld::AddScript(Actor, Script);
+    FString ErrorMessage;
+    if (!TestTrue(TEXT("Script executed"), Component->ExecuteScript(ErrorMessage)))
+    {
+        AddError(ErrorMessage);
+        return false;
+    }
+
+    // Batched scripts are ticked by the subsystem only, never by their own tick function
+    TestEqual(TEXT("Ticked scripts"), TickSubsystem->GetNumTicked(), 1);
+    TestFalse(TEXT("Component tick function enabled"), Component->IsComponentTickEnabled());
+    TickSubsystem->Tick(0.02f);
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks"), GetTicks(Component), 2);
+
+    // Enabling the component tick turns the batched tick on and off instead of the tick function
+    Component->SetComponentTickEnabled(false);
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks with the tick disabled"), GetTicks(Component), 2);
+    Component->SetComponentTickEnabled(true);
+    TestFalse(TEXT("Component tick function enabled"), Component->IsComponentTickEnabled());
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks with the tick enabled again"), GetTicks(Component), 3);
+
+    // Inactive components don't tick
+    Component->Deactivate();
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks while inactive"), GetTicks(Component), 3);
+    Component->Activate();
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks once active again"), GetTicks(Component), 4);
+
+    // The component's tick interval is respected
+    Component->PrimaryComponentTick.TickInterval = 0.05f;
+    TickSubsystem->Tick(0.02f);
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks within the tick interval"), GetTicks(Component), 4);
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks after the tick interval"), GetTicks(Component), 5);
+    Component->PrimaryComponentTick.TickInterval = 0.0f;
+
+    // Pooled actors are parked and their scripts stop ticking
+    TestTrue(TEXT("Released to the pool"), Pool->Release(Actor));
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks while pooled"), GetTicks(Component), 5);
+    TestTrue(TEXT("Acquired from the pool"), Pool->Acquire(AActor::StaticClass(), FTransform::Identity) == Actor);
+    TickSubsystem->Tick(0.02f);
+    TestEqual(TEXT("Ticks once acquired again"), GetTicks(Component), 6);
+
+    // Destroying the actor unregisters the script
+    Actor->Destroy();
+    TestEqual(TEXT("Ticked scripts after destroy"), TickSubsystem->GetNumTicked(), 0);
+
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LuaActorPoolSubsystem.generated.h"
+
+class AActor;
+
+/**
+ * Usage counters of one class's pool
+ */
+struct FLuaActorPoolStats
+{
+    /** Actors waiting in the pool */
+    int32 NumFree = 0;
+
+    /** Actors spawned for the pool (by Acquire misses and Prewarm) */
+    int32 NumSpawned = 0;
+
+    /** Calls to Acquire */
+    int32 NumAcquired = 0;
+
+    /** Acquires served by an actor from the pool */
+    int32 NumReused = 0;
+
+    /** Actors returned by Release */
+    int32 NumReleased = 0;
+};
+
+/**
+ * Per-world, per-class pools of actors for scripts that spawn and destroy the same kinds of actors at high rates
+ * Released actors are hidden, lose collision and stop ticking instead of being destroyed, and are handed out again
+ * with a new transform by Acquire, saving actor construction, component registration and garbage collection
+ */
+UCLASS()
+class LUASCRIPTING_API ULuaActorPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /**
+     * Take an actor of the class from the pool, or spawn one if the pool is empty
+     * @param Class The actor class
+     * @param Transform Transform given to the actor
+     * @return The active actor, or nullptr if spawning failed
+     */
+    AActor* Acquire(UClass* Class, const FTransform& Transform);
+
+    /**
+     * Deactivate an actor and return it to its class's pool
+     * The actor is destroyed instead if the pool is full
+     * @param Actor The actor to release
+     * @return True if the actor was pooled or destroyed, false if it was invalid or already pooled
+     */
+    bool Release(AActor* Actor);
+
+    /**
+     * Spawn inactive actors into a class's pool ahead of time
+     * @param Class The actor class
+     * @param Count Number of actors the pool should hold
+     * @return Number of actors spawned
+     */
+    int32 Prewarm(UClass* Class, int32 Count);
+
+    /**
+     * Get the counters of a class's pool
+     * @param Class The actor class
+     * @return The counters, all zero if the class has no pool
+     */
+    FLuaActorPoolStats GetStats(UClass* Class) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FPool
+    {
+        TArray<TWeakObjectPtr<AActor>> FreeActors;
+        FLuaActorPoolStats Stats;
+    };
+
+    /** Find or create the pool of a class */
+    FPool& FindOrAddPool(UClass* Class);
+
+    /** Spawn an actor for the pool */
+    AActor* SpawnPooledActor(UClass* Class, const FTransform& Transform);
+
+    /** Hide and disable an actor */
+    static void Deactivate(AActor* Actor);
+
+    /** Undo Deactivate */
+    static void Activate(AActor* Actor);
+
+    // Pools by exact class; heap allocated so references stay valid while activating or deactivating an actor runs
+    // overlap events, whose Lua handlers may acquire or release actors of other classes and grow the map
+    TMap<TObjectKey<UClass>, TUniquePtr<FPool>> Pools;
+
+    // Actors currently sitting in a pool, guards against double release
+    TSet<TObjectKey<AActor>> PooledActors;
+};
\ No newline at end of file
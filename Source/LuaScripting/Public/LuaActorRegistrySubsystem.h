@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LuaActorRegistrySubsystem.generated.h"
+
+class AActor;
+class ULevel;
+
+/**
+ * Per-world index of actors used by the Lua actor lookups (UE.Actor.FindActor, UE.Actor.FindActorsOfClass,
+ * UE.Actor.FindByTag)
+ * The index is built the first time a script queries the world and is then kept up to date through the world's
+ * actor spawned/destroyed delegates, level streaming and (in the editor) actor label changes
+ */
+UCLASS()
+class LUASCRIPTING_API ULuaActorRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /**
+     * Find an actor by object name or, in editor builds, by actor label
+     * @param Name The name or label to look for
+     * @param ExactName If set, only names and labels equal to it case-sensitively match; FNames ignore case
+     * @return The first matching actor, or nullptr if none
+     */
+    AActor* FindActorByName(FName Name, const TCHAR* ExactName = nullptr);
+
+    /**
+     * Collect all actors of a class
+     * @param Class The class to look for
+     * @param bIncludeDerived Whether actors of subclasses are included
+     * @param OutActors Receives the matching actors (appended)
+     */
+    void FindActorsOfClass(UClass* Class, bool bIncludeDerived, TArray<AActor*>& OutActors);
+
+    /**
+     * Collect all actors with a tag
+     * @param Tag The tag to look for
+     * @param OutActors Receives the matching actors (appended, unordered)
+     */
+    void FindActorsWithTag(FName Tag, TArray<AActor*>& OutActors);
+
+    /**
+     * Add a tag to an actor and index it
+     * @param Actor The actor
+     * @param Tag The tag to add
+     * @return True if the actor did not have the tag yet
+     */
+    bool AddActorTag(AActor* Actor, FName Tag);
+
+    /**
+     * Remove a tag from an actor and unindex it
+     * @param Actor The actor
+     * @param Tag The tag to remove
+     * @return True if the actor had the tag
+     */
+    bool RemoveActorTag(AActor* Actor, FName Tag);
+
+    /**
+     * Re-index the tags of an actor, for native code that edits AActor::Tags directly
+     * @param Actor The actor
+     */
+    void RefreshActorTags(AActor* Actor);
+
+    /**
+     * Number of actors currently indexed
+     * @return The number of indexed actors, 0 until the index is first used
+     */
+    int32 GetNumActors() const { return Entries.Num(); }
+
+    /**
+     * Build the index from the world's current actors if it has not been built yet (game thread only)
+     * Lookups build it on first use; call this before queries are made from worker threads
+     */
+    void EnsureBuilt();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Keys an actor was indexed under, so it can be removed without recomputing them */
+    struct FEntry
+    {
+        FName Name;
+        FName Label;
+        TObjectKey<UClass> Class;
+        TArray<FName, TInlineAllocator<4>> Tags;
+    };
+
+    /** Drop everything indexed so far */
+    void ResetIndex();
+
+    void AddActor(AActor* Actor);
+    void RemoveActor(AActor* Actor);
+
+    void AddTagEntries(AActor* Actor, FEntry& Entry);
+    void RemoveTagEntries(AActor* Actor, FEntry& Entry);
+
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* InWorld);
+    void OnLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld);
+#if WITH_EDITOR
+    void OnActorLabelChanged(AActor* Actor);
+#endif
+
+    // Whether the index reflects the world's actors
+    bool bBuilt = false;
+
+    // Indexed actors and the keys they were indexed under
+    TMap<TObjectKey<AActor>, FEntry> Entries;
+
+    // Name and label indexes, several actors may share a name across levels
+    TMultiMap<FName, TWeakObjectPtr<AActor>> ActorsByName;
+    TMultiMap<FName, TWeakObjectPtr<AActor>> ActorsByLabel;
+
+    // Actors by exact class
+    TMap<TObjectKey<UClass>, TSet<TWeakObjectPtr<AActor>>> ActorsByClass;
+
+    // Actors by tag
+    TMap<FName, TSet<TWeakObjectPtr<AActor>>> ActorsByTag;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+#if WITH_EDITOR
+    FDelegateHandle ActorLabelChangedHandle;
+#endif
+};
\ No newline at end of file
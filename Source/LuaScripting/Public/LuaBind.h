@@ -0,0 +1,306 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LuaBinding.h"
+#include "LuaValueTypes.h"
+#include "LuaStringBridge.h"
+#include "LuaPropertyMarshal.h"
+#include "Templates/Models.h"
+#include <type_traits>
+#include <utility>
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+/**
+ * Compile-time generation of lua_CFunctions from C++ functions
+ *
+ * LuaBind<&AActor::SetActorHiddenInGame>() produces a lua_CFunction that reads the object from argument 1 and the
+ * parameters from the following arguments, calls the member function and pushes its result. Free functions read
+ * their parameters from argument 1 on. Argument and result conversions are picked per type at compile time through
+ * TLuaValue, so a call costs the same as a hand-written binding without any of its boilerplate
+ *
+ * Functions with default arguments, overloads or extra logic are bound through a small free function taking the
+ * object as its first parameter. Further types are supported by specializing LuaBindTypes::TLuaValue
+ */
+namespace LuaBindTypes
+{
+    /**
+     * Conversion of one C++ type to and from Lua
+     * Specializations provide Get (read an argument, returning false if it has the wrong type), ArgError (raise the
+     * Lua error for an argument Get rejected) and Push. Get never raises: a Lua error unwinds with longjmp, which
+     * would skip the destructors of the arguments already read (FString, structs)
+     */
+    template<typename T, typename Enable = void>
+    struct TLuaValue
+    {
+        static_assert(sizeof(T) == 0, "No Lua conversion for this type, add a TLuaValue specialization");
+    };
+
+    template<>
+    struct TLuaValue<bool>
+    {
+        static bool Get(lua_State* L, int Index, bool& OutValue) { OutValue = lua_toboolean(L, Index) != 0; return true; }
+        static int ArgError(lua_State* L, int Index) { return 0; }
+        static void Push(lua_State* L, bool Value) { lua_pushboolean(L, Value); }
+    };
+
+    template<typename T>
+    struct TLuaValue<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    {
+        static bool Get(lua_State* L, int Index, T& OutValue)
+        {
+            int IsInteger = 0;
+            OutValue = (T)lua_tointegerx(L, Index, &IsInteger);
+            return IsInteger != 0;
+        }
+        static int ArgError(lua_State* L, int Index) { luaL_checkinteger(L, Index); return 0; }
+        static void Push(lua_State* L, T Value) { lua_pushinteger(L, (lua_Integer)Value); }
+    };
+
+    template<typename T>
+    struct TLuaValue<T, std::enable_if_t<std::is_enum_v<T>>>
+    {
+        static bool Get(lua_State* L, int Index, T& OutValue)
+        {
+            int IsInteger = 0;
+            OutValue = (T)lua_tointegerx(L, Index, &IsInteger);
+            return IsInteger != 0;
+        }
+        static int ArgError(lua_State* L, int Index) { luaL_checkinteger(L, Index); return 0; }
+        static void Push(lua_State* L, T Value) { lua_pushinteger(L, (lua_Integer)Value); }
+    };
+
+    template<typename T>
+    struct TLuaValue<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        static bool Get(lua_State* L, int Index, T& OutValue)
+        {
+            int IsNumber = 0;
+            OutValue = (T)lua_tonumberx(L, Index, &IsNumber);
+            return IsNumber != 0;
+        }
+        static int ArgError(lua_State* L, int Index) { luaL_checknumber(L, Index); return 0; }
+        static void Push(lua_State* L, T Value) { lua_pushnumber(L, (lua_Number)Value); }
+    };
+
+    template<>
+    struct TLuaValue<FVector>
+    {
+        static bool Get(lua_State* L, int Index, FVector& OutValue) { return FLuaValueTypes::GetVector(L, Index, OutValue); }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "FVector"); }
+        static void Push(lua_State* L, const FVector& Value) { FLuaValueTypes::PushVector(L, Value); }
+        static void Push(lua_State* L, const FVector& Value, int OutIndex) { FLuaValueTypes::PushVector(L, Value, OutIndex); }
+    };
+
+    template<>
+    struct TLuaValue<FRotator>
+    {
+        static bool Get(lua_State* L, int Index, FRotator& OutValue) { return FLuaValueTypes::GetRotator(L, Index, OutValue); }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "FRotator"); }
+        static void Push(lua_State* L, const FRotator& Value) { FLuaValueTypes::PushRotator(L, Value); }
+        static void Push(lua_State* L, const FRotator& Value, int OutIndex) { FLuaValueTypes::PushRotator(L, Value, OutIndex); }
+    };
+
+    template<>
+    struct TLuaValue<FQuat>
+    {
+        static bool Get(lua_State* L, int Index, FQuat& OutValue) { return FLuaValueTypes::GetQuat(L, Index, OutValue); }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "FQuat"); }
+        static void Push(lua_State* L, const FQuat& Value) { FLuaValueTypes::PushQuat(L, Value); }
+        static void Push(lua_State* L, const FQuat& Value, int OutIndex) { FLuaValueTypes::PushQuat(L, Value, OutIndex); }
+    };
+
+    template<>
+    struct TLuaValue<FTransform>
+    {
+        static bool Get(lua_State* L, int Index, FTransform& OutValue) { return FLuaValueTypes::GetTransform(L, Index, OutValue); }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "FTransform"); }
+        static void Push(lua_State* L, const FTransform& Value) { FLuaValueTypes::PushTransform(L, Value); }
+        static void Push(lua_State* L, const FTransform& Value, int OutIndex) { FLuaValueTypes::PushTransform(L, Value, OutIndex); }
+    };
+
+    template<>
+    struct TLuaValue<FName>
+    {
+        static bool Get(lua_State* L, int Index, FName& OutValue)
+        {
+            if (!lua_isstring(L, Index))
+            {
+                return false;
+            }
+            OutValue = FLuaStringBridge::ToName(L, Index);
+            return true;
+        }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "string"); }
+        static void Push(lua_State* L, FName Value) { FLuaStringBridge::PushName(L, Value); }
+    };
+
+    template<>
+    struct TLuaValue<FString>
+    {
+        static bool Get(lua_State* L, int Index, FString& OutValue)
+        {
+            if (!lua_isstring(L, Index))
+            {
+                return false;
+            }
+            OutValue = FLuaStringBridge::ToTCHAR(L, Index);
+            return true;
+        }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "string"); }
+        static void Push(lua_State* L, const FString& Value) { FLuaStringBridge::PushString(L, Value); }
+    };
+
+    /** Other USTRUCTs (FHitResult, FLinearColor, ...) convert to and from tables through FLuaPropertyMarshal */
+    template<typename T>
+    struct TLuaValue<T, std::enable_if_t<TModels_V<CStaticStructProvider, T>>>
+    {
+        static bool Get(lua_State* L, int Index, T& OutValue) { return FLuaPropertyMarshal::ReadStruct(L, Index, OutValue); }
+        static int ArgError(lua_State* L, int Index) { return luaL_typeerror(L, Index, "table"); }
+
+        static void Push(lua_State* L, const T& Value) { FLuaPropertyMarshal::PushStruct(L, Value); }
+        static void Push(lua_State* L, const T& Value, int OutIndex) { FLuaPropertyMarshal::PushStruct(L, Value, OutIndex); }
+    };
+
+    /**
+     * Raise an argument error naming the expected class
+     * The message is built on the Lua stack from the class's FName, so no C++ temporaries are alive when the error
+     * unwinds the stack
+     */
+    inline int ClassArgError(lua_State* L, int Index, const UClass* Class, const char* Suffix)
+    {
+        FLuaStringBridge::PushName(L, Class->GetFName());
+        return luaL_argerror(L, Index, lua_pushfstring(L, "%s expected%s", lua_tostring(L, -1), Suffix));
+    }
+
+    /** UObject pointers; nil reads as nullptr, anything that is not an object of the class raises an error */
+    template<typename T>
+    struct TLuaValue<T*, std::enable_if_t<std::is_base_of_v<UObject, T>>>
+    {
+        static bool Get(lua_State* L, int Index, T*& OutValue)
+        {
+            OutValue = lua_isnoneornil(L, Index) ? nullptr : Cast<T>(FLuaBinding::GetUObject(L, Index));
+            return OutValue || lua_isnoneornil(L, Index);
+        }
+
+        static int ArgError(lua_State* L, int Index) { return ClassArgError(L, Index, T::StaticClass(), ""); }
+
+        static void Push(lua_State* L, T* Value) { FLuaBinding::PushUObject(L, const_cast<std::remove_const_t<T>*>(Value)); }
+    };
+
+    /** Conversion used for a parameter or result type, ignoring references and const */
+    template<typename T>
+    using TLuaValueFor = TLuaValue<std::remove_cv_t<std::remove_reference_t<T>>>;
+
+    /** Result types that can be written into a destination passed by the script instead of a new value */
+    template<typename T, typename = void>
+    struct TSupportsOutValue : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct TSupportsOutValue<T, std::void_t<decltype(TLuaValueFor<T>::Push(std::declval<lua_State*>(), std::declval<const std::remove_cv_t<std::remove_reference_t<T>>&>(), 0))>> : std::true_type
+    {
+    };
+
+    /**
+     * Calls a function with arguments read from the stack and pushes its result
+     * Struct results (FVector, FHitResult, ...) are written into an optional destination passed after the last
+     * parameter, so getters called every frame can reuse one value instead of creating garbage
+     */
+    template<typename ResultType, typename... ArgTypes>
+    struct TInvoker
+    {
+        template<typename CallableType, size_t... Indices>
+        static FORCEINLINE int Call(lua_State* L, int FirstArg, CallableType&& Callable, std::index_sequence<Indices...>)
+        {
+            // Arguments are all read before the call, and an error is raised once they are destroyed
+            int BadArg = 0;
+            {
+                TTuple<std::remove_cv_t<std::remove_reference_t<ArgTypes>>...> Args;
+                if (((TLuaValueFor<ArgTypes>::Get(L, FirstArg + (int)Indices, Args.template Get<Indices>()) || (BadArg = FirstArg + (int)Indices, false)) && ...))
+                {
+                    if constexpr (std::is_void_v<ResultType>)
+                    {
+                        Callable(static_cast<ArgTypes&&>(Args.template Get<Indices>())...);
+                        return 0;
+                    }
+                    else if constexpr (TSupportsOutValue<ResultType>::value)
+                    {
+                        const int OutIndex = FirstArg + (int)sizeof...(ArgTypes);
+                        TLuaValueFor<ResultType>::Push(L, Callable(static_cast<ArgTypes&&>(Args.template Get<Indices>())...), OutIndex);
+                        return 1;
+                    }
+                    else
+                    {
+                        TLuaValueFor<ResultType>::Push(L, Callable(static_cast<ArgTypes&&>(Args.template Get<Indices>())...));
+                        return 1;
+                    }
+                }
+            }
+
+            ((FirstArg + (int)Indices == BadArg ? TLuaValueFor<ArgTypes>::ArgError(L, BadArg) : 0), ...);
+            return 0;
+        }
+    };
+
+    /** Read the object a member function is called on, raising an error if it is missing or of the wrong class */
+    template<typename ClassType>
+    FORCEINLINE ClassType* CheckSelf(lua_State* L)
+    {
+        ClassType* Self = Cast<ClassType>(FLuaBinding::GetUObject(L, 1));
+        if (!Self)
+        {
+            ClassArgError(L, 1, ClassType::StaticClass(), " (use ':' to call methods)");
+        }
+        return Self;
+    }
+
+    template<auto Function, typename FunctionType = decltype(Function)>
+    struct TBinding;
+
+    /** Free function: parameters start at argument 1 */
+    template<auto Function, typename ResultType, typename... ArgTypes>
+    struct TBinding<Function, ResultType(*)(ArgTypes...)>
+    {
+        static int Call(lua_State* L)
+        {
+            return TInvoker<ResultType, ArgTypes...>::Call(L, 1, Function, std::index_sequence_for<ArgTypes...>());
+        }
+    };
+
+    /** Member function: the object is argument 1, parameters follow */
+    template<auto Function, typename ClassType, typename ResultType, typename... ArgTypes>
+    struct TBinding<Function, ResultType(ClassType::*)(ArgTypes...)>
+    {
+        static int Call(lua_State* L)
+        {
+            ClassType* Self = CheckSelf<ClassType>(L);
+            return TInvoker<ResultType, ArgTypes...>::Call(L, 2, [Self](auto&&... Args) -> decltype(auto) { return (Self->*Function)(Forward<decltype(Args)>(Args)...); }, std::index_sequence_for<ArgTypes...>());
+        }
+    };
+
+    template<auto Function, typename ClassType, typename ResultType, typename... ArgTypes>
+    struct TBinding<Function, ResultType(ClassType::*)(ArgTypes...) const>
+    {
+        static int Call(lua_State* L)
+        {
+            const ClassType* Self = CheckSelf<ClassType>(L);
+            return TInvoker<ResultType, ArgTypes...>::Call(L, 2, [Self](auto&&... Args) -> decltype(auto) { return (Self->*Function)(Forward<decltype(Args)>(Args)...); }, std::index_sequence_for<ArgTypes...>());
+        }
+    };
+}
+
+/**
+ * Get the lua_CFunction generated for a C++ function or member function
+ * @return The function, usable with lua_pushcfunction or in a luaL_Reg table
+ */
+template<auto Function>
+constexpr lua_CFunction LuaBind()
+{
+    return &LuaBindTypes::TBinding<Function>::Call;
+}
\ No newline at end of file
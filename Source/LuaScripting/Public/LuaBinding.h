@@ -6,6 +6,11 @@
 struct lua_State;
 class AActor;
 class UWorld;
+class FLuaBuffer;
+class ULuaActorPoolSubsystem;
+class ULuaSpatialIndexSubsystem;
+class FLuaEventBus;
+class FMulticastDelegateProperty;
 
 /**
  * Class for binding Unreal Engine functionality to Lua
@@ -37,6 +42,12 @@ public:
      */
     static void RegisterActorFunctions(lua_State* L);
 
+    /**
+     * Register world query functions with the Lua state
+     * @param L The Lua state to register functions with
+     */
+    static void RegisterWorldFunctions(lua_State* L);
+
     /**
      * Get the current UWorld from the Lua state
      * @param L The Lua state
@@ -55,7 +66,7 @@ public:
      * Get a UObject from the Lua stack
      * @param L The Lua state
      * @param Index The stack index
-     * @return The UObject at the given stack index or nullptr if not a UObject
+     * @return The UObject at the given stack index, or nullptr if not a UObject or the object is no longer alive
      */
     static UObject* GetUObject(lua_State* L, int Index);
 
@@ -71,13 +82,13 @@ private:
     // Method dispatching
     static int UObjectIndex(lua_State* L);
     static int UObjectToString(lua_State* L);
-    static int DispatchUObjectMethod(lua_State* L, UObject* Object, const char* MethodName);
+    static int UObjectEquals(lua_State* L);
 
-    // Helper functions for common UE structs
-    static void PushVector(lua_State* L, const FVector& Vector);
-    static FVector GetVector(lua_State* L, int Index);
-    static void PushRotator(lua_State* L, const FRotator& Rotator);
-    static FRotator GetRotator(lua_State* L, int Index);
+    // Multicast delegate proxies (object.OnSomething:Add(fn))
+    static void PushMulticastDelegate(lua_State* L, UObject* Object, FMulticastDelegateProperty* Property);
+    static int Lua_DelegateAdd(lua_State* L);
+    static int Lua_DelegateRemove(lua_State* L);
+    static int Lua_DelegateClear(lua_State* L);
 
     // Core function implementations (Lua C functions)
     static int Lua_GetWorld(lua_State* L);
@@ -86,9 +97,58 @@ private:
     static int Lua_Trace(lua_State* L);
     static int Lua_Warning(lua_State* L);
     static int Lua_Error(lua_State* L);
+    static int LogMessage(lua_State* L, ELogVerbosity::Type Verbosity);
     static int Lua_FindActor(lua_State* L);
+    static int Lua_FindActorsOfClass(lua_State* L);
+    static int Lua_FindByTag(lua_State* L);
     static int Lua_SpawnActor(lua_State* L);
     static int Lua_DestroyActor(lua_State* L);
+    static int Lua_SpawnMany(lua_State* L);
+    static int Lua_Acquire(lua_State* L);
+    static int Lua_Release(lua_State* L);
+    static int Lua_Prewarm(lua_State* L);
+    static int Lua_GetPoolStats(lua_State* L);
+    static int Lua_TrackClass(lua_State* L);
+    static int Lua_TrackTag(lua_State* L);
+    static int Lua_Track(lua_State* L);
+    static int Lua_Untrack(lua_State* L);
+    static int Lua_QueryRadius(lua_State* L);
+    static int Lua_QueryBox(lua_State* L);
+    static int Lua_QueryNearest(lua_State* L);
+    static int Lua_SetLocations(lua_State* L);
+    static int Lua_SetRotations(lua_State* L);
+    static int Lua_SetScales(lua_State* L);
+    static int Lua_SetTransforms(lua_State* L);
+    static int Lua_RegisterEvent(lua_State* L);
+    static int Lua_TriggerEvent(lua_State* L);
+    static int Lua_UnregisterEvent(lua_State* L);
+    static int Lua_BroadcastEvent(lua_State* L);
+    static int Lua_PostEvent(lua_State* L);
+    static int Lua_PostCoalescedEvent(lua_State* L);
+
+    // Resolve the actor class named by the string at the given stack index, nullptr if it is not an actor class
+    static UClass* FindActorClass(lua_State* L, int Index);
+
+    // Read a spawn transform: a Transform, or an optional location and optional rotation, starting at the given stack index
+    static FTransform GetSpawnTransform(lua_State* L, int Index);
+
+    // Actor pool of the script's world
+    static ULuaActorPoolSubsystem* GetActorPool(lua_State* L);
+
+    // Spatial index of the script's world
+    static ULuaSpatialIndexSubsystem* GetSpatialIndex(lua_State* L);
+
+    // Push an array of actors, refilling the table at OutIndex instead of creating one if there is a table there
+    static void PushActorArray(lua_State* L, TConstArrayView<AActor*> Actors, int OutIndex);
+
+    // Apply packed per-actor locations/rotations/scales (any may be null) to the actor array at stack index 1
+    static int32 ApplyActorTransforms(lua_State* L, const FLuaBuffer* Locations, const FLuaBuffer* Rotations, const FLuaBuffer* Scales);
+
+    // Event handlers of the state, raises a Lua error if the state has no native context
+    static FLuaEventBus& GetEventBus(lua_State* L);
+
+    // Queue an event of the state, the arguments (after the event name) start with the coalescing key if it is not None
+    static int PostEvent(lua_State* L, FName CoalesceKey);
 
     // Helper function to register the event system
     static void RegisterEventSystem(lua_State* L);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+struct lua_State;
+
+/** Element type of a Lua buffer */
+enum class ELuaBufferType : uint8
+{
+    Float32,
+    Float64,
+    Int32
+};
+
+/**
+ * Typed, contiguous numeric array living inside a Lua userdata (UE.Buffer)
+ * The elements follow the header in the same allocation, so C++ bindings can read and write them in place
+ * through a TArrayView without building or parsing Lua tables
+ */
+class LUASCRIPTING_API FLuaBuffer
+{
+public:
+    /**
+     * Register the buffer metatable and the UE.Buffer namespace
+     * @param L The Lua state to register with (the UE table must already exist)
+     */
+    static void Register(lua_State* L);
+
+    /**
+     * Create a zero-initialized buffer and push it to the Lua stack
+     * @param L The Lua state
+     * @param Type Element type
+     * @param Num Number of elements
+     * @return The new buffer (owned by Lua)
+     */
+    static FLuaBuffer* Push(lua_State* L, ELuaBufferType Type, int32 Num);
+
+    /**
+     * Create a copy of a buffer and push it to the Lua stack
+     * @param L The Lua state
+     * @param Source The buffer to copy
+     * @return The new buffer (owned by Lua)
+     */
+    static FLuaBuffer* PushCopy(lua_State* L, const FLuaBuffer& Source);
+
+    /**
+     * Get the buffer at the given stack index
+     * @param L The Lua state
+     * @param Index The stack index
+     * @return The buffer, or nullptr if the value is not a buffer
+     */
+    static FLuaBuffer* ToBuffer(lua_State* L, int Index);
+
+    /**
+     * Get the buffer at the given stack index, raising a Lua error if the value is not a buffer
+     */
+    static FLuaBuffer* CheckBuffer(lua_State* L, int Index);
+
+    /** Element type of this buffer */
+    ELuaBufferType GetType() const { return Type; }
+
+    /** Number of elements in this buffer */
+    int32 Num() const { return NumElements; }
+
+    /**
+     * View the elements as float32/float64/int32
+     * @return The view, or an empty view if the buffer holds a different element type
+     */
+    TArrayView<float> GetFloat32View() { return Type == ELuaBufferType::Float32 ? TArrayView<float>(static_cast<float*>(GetData()), NumElements) : TArrayView<float>(); }
+    TArrayView<double> GetFloat64View() { return Type == ELuaBufferType::Float64 ? TArrayView<double>(static_cast<double*>(GetData()), NumElements) : TArrayView<double>(); }
+    TArrayView<int32> GetInt32View() { return Type == ELuaBufferType::Int32 ? TArrayView<int32>(static_cast<int32*>(GetData()), NumElements) : TArrayView<int32>(); }
+
+    /** Read an element as a double, whatever the element type (0-based index, not bounds checked) */
+    double GetElement(int32 Index) const;
+
+    /** Write an element from a double, converting to the element type (0-based index, not bounds checked) */
+    void SetElement(int32 Index, double Value);
+
+    /** Read the packed X, Y, Z triple starting at element VectorIndex * 3 (0-based, not bounds checked) */
+    FVector GetVector(int32 VectorIndex) const
+    {
+        const int32 Element = VectorIndex * 3;
+        return FVector(GetElement(Element), GetElement(Element + 1), GetElement(Element + 2));
+    }
+
+    /** Write the packed X, Y, Z triple starting at element VectorIndex * 3 (0-based, not bounds checked) */
+    void SetVector(int32 VectorIndex, const FVector& Value)
+    {
+        const int32 Element = VectorIndex * 3;
+        SetElement(Element, Value.X);
+        SetElement(Element + 1, Value.Y);
+        SetElement(Element + 2, Value.Z);
+    }
+
+    /** Number of packed X, Y, Z triples in this buffer */
+    int32 NumVectors() const { return NumElements / 3; }
+
+    /** Size in bytes of one element of the given type */
+    static int32 GetElementSize(ELuaBufferType InType);
+
+private:
+    FLuaBuffer(ELuaBufferType InType, int32 InNum)
+        : Type(InType)
+        , NumElements(InNum)
+    {
+    }
+
+    // Elements start after the header, padded so doubles and SIMD loads stay aligned
+    static constexpr SIZE_T HeaderSize = 16;
+
+    void* GetData() { return reinterpret_cast<uint8*>(this) + HeaderSize; }
+    const void* GetData() const { return reinterpret_cast<const uint8*>(this) + HeaderSize; }
+
+    ELuaBufferType Type;
+    int32 NumElements;
+};
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+// Forward declarations
+struct lua_State;
+struct FStreamableManager;
+struct FStreamableHandle;
+
+/**
+ * Name to UClass cache shared by the Lua bindings (UE.Actor.SpawnActor, IsA, ...)
+ * Accepts short class names ("StaticMeshActor"), full object paths ("/Script/Engine.StaticMeshActor") and
+ * soft class paths ("/Game/Blueprints/BP_Enemy.BP_Enemy_C", optionally in Class'...' export form)
+ * Only successful lookups are cached, as weak references, so classes that are loaded later are found on the next
+ * lookup and unloaded or reinstanced classes resolve again; everything is dropped after a hot reload
+ */
+class LUASCRIPTING_API FLuaClassCache
+{
+public:
+    /**
+     * Access the process-wide cache
+     * @return Reference to the singleton instance
+     */
+    static FLuaClassCache& Get();
+
+    /**
+     * Start listening for hot reloads
+     */
+    void Startup();
+
+    /**
+     * Stop listening for hot reloads and release preloaded classes
+     */
+    void Shutdown();
+
+    /**
+     * Resolve a class by name or path (game thread, or the scripts of a parallel tick)
+     * @param Name Short name, object path or soft class path
+     * @param bLoad Whether a path that is not loaded yet may be loaded synchronously (never from a parallel tick)
+     * @return The class, or nullptr if it cannot be resolved
+     */
+    UClass* FindClass(const TCHAR* Name, bool bLoad = false);
+
+    /**
+     * Start loading a class asynchronously so a later FindClass does not have to load it
+     * @param Name Soft class path of the class
+     * @return True if the class is already loaded, false if loading started (or the path is invalid)
+     */
+    bool Preload(const TCHAR* Name);
+
+    /**
+     * Drop all cached lookups
+     */
+    void Clear();
+
+    /**
+     * Register the UE.Class functions with a Lua state
+     * @param L The Lua state to register functions with
+     */
+    static void Register(lua_State* L);
+
+private:
+    FLuaClassCache();
+    ~FLuaClassCache();
+
+    // Disallow copying and assignment
+    FLuaClassCache(const FLuaClassCache&) = delete;
+    FLuaClassCache& operator=(const FLuaClassCache&) = delete;
+
+    /** Uncached lookup */
+    static UClass* ResolveClass(const TCHAR* Name, bool bLoad);
+
+    /** Whether the name is an object path rather than a short class name */
+    static bool IsPath(const TCHAR* Name);
+
+    // Resolved classes by the name they were requested with, locked for the scripts of a parallel tick
+    TMap<FName, TWeakObjectPtr<UClass>> Classes;
+    FRWLock ClassesLock;
+
+    // Used for asynchronous preloading, classes stay loaded while their handle is kept
+    TUniquePtr<FStreamableManager> StreamableManager;
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> PreloadHandles;
+
+    FDelegateHandle ReloadCompleteHandle;
+};
\ No newline at end of file
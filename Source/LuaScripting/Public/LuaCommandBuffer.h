@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Include Lua headers
+extern "C" {
+#include "lua.h"
+}
+
+/**
+ * Calls recorded by scripts ticking on worker threads, replayed on the game thread after the parallel tick
+ *
+ * Bindings that change the world are registered through Deferrable: on the game thread they run as usual, while
+ * recording they copy their arguments into the calling state and return nothing. Their arguments are kept in the
+ * state until the call is applied; value types (FVector, ...), buffers and tables are copied when recorded, so the
+ * script may reuse them right away. Calls of one state are applied in the order they were made. Only fire-and-forget bindings are
+ * deferrable, at most returning a status the caller can do without. Bindings whose result is needed right away (an
+ * actor, a handle to unbind later, a count) or that yield are registered through GameThreadOnly and raise an error
+ * while recording
+ */
+class LUASCRIPTING_API FLuaCommandBuffer
+{
+public:
+    /**
+     * Check whether the calling thread is running scripts of a parallel tick
+     * @return True if world changes must be recorded instead of made
+     */
+    static bool IsRecording();
+
+    /**
+     * Record a call of a binding with the arguments on the stack
+     * @param L The calling Lua state
+     * @param Function The binding to call on the game thread
+     * @return Number of results (none)
+     */
+    static int Record(lua_State* L, lua_CFunction Function);
+
+    /** Binding that is recorded when called from a parallel tick */
+    template<lua_CFunction Function>
+    static int Deferrable(lua_State* L)
+    {
+        return IsRecording() ? Record(L, Function) : Function(L);
+    }
+
+    /** Binding that raises an error when called from a parallel tick */
+    template<lua_CFunction Function>
+    static int GameThreadOnly(lua_State* L)
+    {
+        return IsRecording() ? RaiseGameThreadOnly(L) : Function(L);
+    }
+
+    /**
+     * Make the calling thread record into a buffer for the lifetime of the scope
+     */
+    class FScopedRecording
+    {
+    public:
+        explicit FScopedRecording(FLuaCommandBuffer& Buffer);
+        ~FScopedRecording();
+
+    private:
+        FLuaCommandBuffer* Previous;
+    };
+
+    /**
+     * Run the recorded calls and empty the buffer (game thread only)
+     * @param ReleasedStates States released by an earlier call (e.g. by destroying a scripted actor), whose calls are dropped
+     */
+    void Apply(const TSet<lua_State*>& ReleasedStates);
+
+    /**
+     * Drop the arguments a state still holds for recorded calls, when the state is reset for another script
+     * @param L The main thread of the Lua state
+     */
+    static void DiscardPendingArguments(lua_State* L);
+
+    /** Number of recorded calls */
+    int32 Num() const { return Commands.Num(); }
+
+private:
+    struct FCommand
+    {
+        lua_State* State;
+        lua_CFunction Function;
+
+        // Slots of the arguments in the state's pending argument table
+        int32 FirstArg;
+        int32 NumArgs;
+    };
+
+    static int RaiseGameThreadOnly(lua_State* L);
+
+    TArray<FCommand> Commands;
+};
\ No newline at end of file
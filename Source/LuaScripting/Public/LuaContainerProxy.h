@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+struct lua_State;
+class FProperty;
+
+/**
+ * Lua access to TArray, TMap and TSet properties
+ * Containers owned by an object are exposed as proxy userdata that read and write the object's memory on access
+ * (indexing, #, pairs and assignment), so reading one element does not copy the whole container. ToTable makes a
+ * snapshot when one is needed. Containers in transient memory (delegate parameters, struct fields) are copied to
+ * tables instead, since the memory is gone once the call returns
+ */
+class LUASCRIPTING_API FLuaContainerProxy
+{
+public:
+    /**
+     * Check whether a property is a container supported by the proxies
+     * @param Property The property
+     * @return True for array, map and set properties
+     */
+    static bool IsContainer(const FProperty* Property);
+
+    /**
+     * Push a proxy over a container property of an object
+     * The proxy keeps a weak reference to the object and raises a Lua error when used after the object is gone
+     * @param L The Lua state
+     * @param Object The object owning the container
+     * @param Property The container property, a member of the object's class
+     */
+    static void Push(lua_State* L, UObject* Object, const FProperty* Property);
+
+    /**
+     * Push a copy of a container as a table (a sequence for arrays, key -> value for maps, key -> true for sets)
+     * @param L The Lua state
+     * @param Property The container property
+     * @param ValuePtr Pointer to the container
+     * @return True if the property is a container, nil is pushed otherwise
+     */
+    static bool PushTable(lua_State* L, const FProperty* Property, const void* ValuePtr);
+
+    /**
+     * Replace the contents of a container with the contents of a table in the same layout as PushTable
+     * Elements that cannot be converted are left at their default value (arrays) or skipped (maps and sets)
+     * @param L The Lua state
+     * @param Index Stack index of the table
+     * @param Property The container property
+     * @param ValuePtr Pointer to the container
+     * @return True if the value at the index is a table and the property a container
+     */
+    static bool ReadTable(lua_State* L, int Index, const FProperty* Property, void* ValuePtr);
+};
\ No newline at end of file
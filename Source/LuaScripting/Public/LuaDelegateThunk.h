@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "LuaDelegateThunk.generated.h"
+
+// Forward declarations
+struct lua_State;
+struct FLuaStateContext;
+class FMulticastDelegateProperty;
+
+/**
+ * Binds a Lua function to a dynamic multicast delegate of an object (OnActorBeginOverlap, OnTakeAnyDamage, ...)
+ * The delegate calls the thunk's placeholder UFunction; ProcessEvent is overridden to marshal the broadcast
+ * parameters with the delegate's signature and call the Lua function, so nothing runs until the event fires
+ * Thunks stay bound until they are removed from Lua, the Lua state they belong to is reset or their target is destroyed
+ */
+UCLASS(Transient)
+class LUASCRIPTING_API ULuaDelegateThunk : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Bind a Lua function to a delegate
+     * @param L The Lua state
+     * @param Target Object owning the delegate
+     * @param Property The delegate property
+     * @param FunctionIndex Stack index of the Lua function
+     * @return Handle of the binding, 0 on failure
+     */
+    static uint32 Bind(lua_State* L, UObject* Target, FMulticastDelegateProperty* Property, int FunctionIndex);
+
+    /**
+     * Remove a binding made by Bind
+     * @param L The Lua state that made the binding
+     * @param Handle The handle returned by Bind
+     * @return True if the binding existed
+     */
+    static bool Unbind(lua_State* L, uint32 Handle);
+
+    /**
+     * Remove every binding a Lua state made on a delegate
+     * @param L The Lua state
+     * @param Target Object owning the delegate
+     * @param Property The delegate property
+     * @return Number of bindings removed
+     */
+    static int32 UnbindAll(lua_State* L, UObject* Target, FMulticastDelegateProperty* Property);
+
+    // UObject interface
+    virtual void ProcessEvent(UFunction* Function, void* Parms) override;
+
+private:
+    /** Placeholder the delegate is bound to, calls end up in ProcessEvent */
+    UFUNCTION()
+    void OnDelegateBroadcast();
+
+    /** Remove from the delegate and release the Lua function */
+    void Release();
+
+    void OnContextReset();
+
+    /** Release the thunks whose target was destroyed, nothing else unroots them when scripts don't remove their bindings */
+    static void ReleaseStaleThunks();
+
+    uint32 Handle = 0;
+
+    TWeakObjectPtr<UObject> Target;
+    FMulticastDelegateProperty* Property = nullptr;
+
+    FLuaStateContext* Context = nullptr;
+    FDelegateHandle ResetHandle;
+
+    // Registry reference of the Lua function
+    int FunctionRef = 0;
+};
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LuaEventPayload.h"
+
+// Forward declarations
+struct lua_State;
+
+/**
+ * Native registry of the event handlers of one Lua state, backing UE.Event
+ * Event names are interned to integer ids and handlers are held as registry references, so scripts can't break
+ * dispatch by editing a Lua table and registering or triggering a known event doesn't allocate
+ */
+class LUASCRIPTING_API FLuaEventBus
+{
+public:
+    /**
+     * Register a handler for an event
+     * @param L The Lua state
+     * @param Event The event name
+     * @param HandlerIndex Stack index of the handler function
+     * @return Handle identifying this handler, never 0
+     */
+    uint32 Register(lua_State* L, FName Event, int HandlerIndex);
+
+    /**
+     * Remove a single handler
+     * @param L The Lua state
+     * @param Handle Handle returned by Register
+     * @return True if the handler was registered
+     */
+    bool Unregister(lua_State* L, uint32 Handle);
+
+    /**
+     * Remove every handler of an event
+     * @param L The Lua state
+     * @param Event The event name
+     * @return Number of handlers removed
+     */
+    int32 UnregisterAll(lua_State* L, FName Event);
+
+    /**
+     * Call the handlers of an event in registration order
+     * Handlers run in protected mode, an error is logged and doesn't stop the remaining handlers
+     * Handlers registered while the event is being dispatched are first called on the next trigger
+     * @param L The Lua state (or one of its threads)
+     * @param Event The event name
+     * @param FirstArg Stack index of the first argument passed to the handlers
+     * @param NumArgs Number of arguments
+     * @return Number of handlers called
+     */
+    int32 Trigger(lua_State* L, FName Event, int FirstArg, int NumArgs);
+
+    /**
+     * Queue an event for the next flush instead of dispatching it now
+     * @param L The Lua state
+     * @param Event The event name
+     * @param FirstArg Stack index of the first argument
+     * @param NumArgs Number of arguments
+     * @param CoalesceKey If not None, replaces the values of an event with the same name and key that is still queued
+     * @param OutError Receives the reason if the arguments can't be queued (static string)
+     * @return True if the event was queued
+     */
+    bool Post(lua_State* L, FName Event, int FirstArg, int NumArgs, FName CoalesceKey, const char*& OutError);
+
+    /**
+     * Dispatch the queued events in the order they were posted
+     * Events posted by their handlers are queued for the next flush
+     * @param L The main thread of the Lua state
+     */
+    void FlushQueue(lua_State* L);
+
+    /**
+     * Number of events waiting for the next flush
+     * @return The queue depth
+     */
+    int32 GetNumQueued() const { return Queue.Num(); }
+
+    /**
+     * Whether an event has any handler
+     * @param Event The event name
+     * @return True if at least one handler is registered
+     */
+    bool HasHandlers(FName Event) const;
+
+    /**
+     * Release every handler (called when the state is pooled again or closed)
+     * @param L The Lua state
+     */
+    void Reset(lua_State* L);
+
+private:
+    struct FHandler
+    {
+        uint32 Handle = 0;
+
+        // Registry reference of the function, LUA_NOREF once removed
+        int Ref = 0;
+    };
+
+    struct FEvent
+    {
+        FName Name;
+        TArray<FHandler, TInlineAllocator<4>> Handlers;
+        int32 NumLive = 0;
+    };
+
+    struct FQueuedEvent
+    {
+        FName Event;
+        FName CoalesceKey;
+
+        // Record of the event's arguments in the queue payload
+        int32 PayloadOffset = 0;
+    };
+
+    /** Dispatch the events being flushed, run in protected mode */
+    static int DispatchQueue(lua_State* L);
+
+    /** Release the reference of a handler, leaving a tombstone until the handler list can be compacted */
+    void RemoveHandler(lua_State* L, FEvent& Event, int32 HandlerIndex);
+
+    /** Drop tombstones once no dispatch is iterating the handler lists */
+    void Compact();
+
+    // Events by id, ids stay stable for the lifetime of the state
+    TArray<FEvent> Events;
+    TMap<FName, int32> EventIds;
+
+    // Event id of every live handler
+    TMap<uint32, int32> HandlerEvents;
+
+    uint32 NextHandle = 1;
+
+    // Posted events and their arguments, swapped with the flushing ones so neither reallocates
+    TArray<FQueuedEvent> Queue;
+    TArray<FQueuedEvent> FlushingQueue;
+    FLuaEventPayload QueuePayload;
+    FLuaEventPayload FlushingPayload;
+
+    // Queue index of the coalescable events, by name and key
+    TMap<TPair<FName, FName>, int32> CoalescedEvents;
+
+    // Nesting level of Trigger calls, handler lists are only compacted at 0
+    int32 DispatchDepth = 0;
+    bool bHasTombstones = false;
+};
\ No newline at end of file
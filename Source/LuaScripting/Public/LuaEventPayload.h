@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+// Forward declarations
+struct lua_State;
+
+/**
+ * Compact binary encoding of Lua values, used to carry event arguments from one Lua state to others
+ * A payload holds any number of records; each record is a list of values encoded once by the sender and decoded
+ * onto the stack of every state that receives it
+ * Supported values are nil, booleans, numbers, strings, UObjects, the UE value types and tables of those
+ */
+class LUASCRIPTING_API FLuaEventPayload
+{
+public:
+    /**
+     * Encode values from the Lua stack as a new record
+     * On failure nothing is added to the payload
+     * @param L The Lua state
+     * @param FirstIndex Stack index of the first value
+     * @param NumValues Number of values
+     * @param OutOffset Receives the offset of the record
+     * @param OutError Receives the reason on failure (static string)
+     * @return True if every value could be encoded
+     */
+    bool Append(lua_State* L, int FirstIndex, int NumValues, int32& OutOffset, const char*& OutError);
+
+    /**
+     * Push the values of a record
+     * @param L The Lua state to decode into
+     * @param Offset Offset returned by Append
+     * @return Number of values pushed, or INDEX_NONE if the stack could not grow
+     */
+    int Push(lua_State* L, int32 Offset) const;
+
+    /** Remove all records, keeping the memory */
+    void Reset();
+
+    /** Size of the encoded records in bytes */
+    int32 GetNumBytes() const { return Bytes.Num(); }
+
+private:
+    bool EncodeValue(lua_State* L, int Index, int32 Depth, const char*& OutError);
+    void DecodeValue(lua_State* L, int32& Offset) const;
+
+    template<typename ValueType>
+    void Write(const ValueType& Value)
+    {
+        Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(ValueType));
+    }
+
+    template<typename ValueType>
+    ValueType Read(int32& Offset) const
+    {
+        ValueType Value;
+        FMemory::Memcpy(&Value, Bytes.GetData() + Offset, sizeof(ValueType));
+        Offset += sizeof(ValueType);
+        return Value;
+    }
+
+    TArray<uint8> Bytes;
+
+    // Objects are referenced by index so they can be held weakly
+    TArray<TWeakObjectPtr<UObject>> Objects;
+};
\ No newline at end of file
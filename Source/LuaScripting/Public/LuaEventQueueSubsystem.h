@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "LuaEventQueueSubsystem.generated.h"
+
+// Forward declarations
+struct lua_State;
+struct FLuaStateContext;
+class ULuaEventQueueSubsystem;
+
+/**
+ * Tick function flushing the queued Lua events of a world once per frame
+ */
+USTRUCT()
+struct FLuaEventQueueTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    /** Subsystem to flush */
+    ULuaEventQueueSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLuaEventQueueTickFunction> : public TStructOpsTypeTraitsBase2<FLuaEventQueueTickFunction>
+{
+    enum
+    {
+        WithCopy = false
+    };
+};
+
+/**
+ * Flushes the events queued with UE.Event.Post by the scripts of a world
+ * Each state with queued events is flushed once per frame, in the tick group set by lua.Event.FlushTickGroup
+ */
+UCLASS()
+class LUASCRIPTING_API ULuaEventQueueSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    /**
+     * Flush the queue of a state at the next flush
+     * @param L The Lua state (or one of its threads)
+     */
+    void MarkPending(lua_State* L);
+
+    /** Flush the queues of every pending state */
+    void Flush();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void OnContextReset(FLuaStateContext* Context);
+
+    FLuaEventQueueTickFunction FlushTickFunction;
+
+    // States with queued events and the handle of their reset listener
+    TMap<FLuaStateContext*, FDelegateHandle> PendingContexts;
+
+    // Contexts being flushed, reused between frames
+    TArray<FLuaStateContext*> FlushingContexts;
+};
\ No newline at end of file
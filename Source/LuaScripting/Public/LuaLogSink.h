@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+/**
+ * Buffered sink for messages logged from Lua (UE.Print and UE.Log)
+ * Bindings push raw UTF-8 messages into a fixed-size lock-free ring buffer; the ring is drained once per frame
+ * on the game thread, where duplicates are coalesced, transcoding happens and on-screen messages are rate limited
+ */
+class LUASCRIPTING_API FLuaLogSink
+{
+public:
+    /**
+     * Access the process-wide sink
+     * @return Reference to the singleton instance
+     */
+    static FLuaLogSink& Get();
+
+    /**
+     * Start flushing the sink once per frame
+     */
+    void Startup();
+
+    /**
+     * Stop the per-frame flush and emit everything still queued
+     */
+    void Shutdown();
+
+    /**
+     * Queue a message, callable from any thread
+     * Messages are dropped (and counted) if the ring buffer is full
+     * @param Verbosity Log verbosity of the message
+     * @param bOnScreen Whether the message should also be shown on screen
+     * @param Utf8Message The message bytes (not necessarily null terminated)
+     * @param Length Number of bytes in the message
+     * @return True if the message was queued
+     */
+    bool Enqueue(ELogVerbosity::Type Verbosity, bool bOnScreen, const char* Utf8Message, int32 Length);
+
+    /**
+     * Check whether a message of the given verbosity would be emitted, so callers can skip formatting it
+     * @param Verbosity Log verbosity of the message
+     * @param bOnScreen Whether the message would also be shown on screen
+     * @return True if the message is worth formatting
+     */
+    static bool IsActive(ELogVerbosity::Type Verbosity, bool bOnScreen);
+
+    /**
+     * Emit all queued messages (game thread only)
+     */
+    void Flush();
+
+private:
+    FLuaLogSink();
+
+    // Disallow copying and assignment
+    FLuaLogSink(const FLuaLogSink&) = delete;
+    FLuaLogSink& operator=(const FLuaLogSink&) = delete;
+
+    struct FEntry
+    {
+        ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+        bool bOnScreen = false;
+
+        // UTF-8 bytes, null terminated; the allocation is recycled between messages
+        TArray<ANSICHAR> Message;
+    };
+
+    struct FSlot
+    {
+        // Sequence number used to hand the slot between producers and the consumer
+        std::atomic<uint32> Sequence;
+        FEntry Entry;
+    };
+
+    /** Take the oldest message, swapping its storage with OutEntry so no allocation happens */
+    bool Dequeue(FEntry& OutEntry);
+
+    /** Write a (possibly repeated) message to the log and the screen */
+    void Emit(const FEntry& Entry, int32 RepeatCount, int32& NumOnScreen);
+
+    bool Tick(float DeltaTime);
+
+    // Ring capacity, must be a power of two
+    static constexpr uint32 Capacity = 4096;
+
+    TUniquePtr<FSlot[]> Slots;
+    std::atomic<uint32> EnqueuePos;
+    uint32 DequeuePos;
+
+    // Messages dropped because the ring was full
+    std::atomic<int32> NumDropped;
+
+    // Consumer-side entries, kept around so flushing does not allocate
+    FEntry Current;
+    FEntry Pending;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+struct lua_State;
+
+/**
+ * Batch vector kernels backing the UE.Math namespace
+ * Vectors are packed as consecutive X, Y, Z floats, so one call processes a whole array with VectorRegister SIMD math
+ * Output views may alias the input views
+ */
+class LUASCRIPTING_API FLuaMathKernels
+{
+public:
+    /**
+     * Register the batch kernels in the table on top of the Lua stack
+     * @param L The Lua state
+     */
+    static void Register(lua_State* L);
+
+    /**
+     * Out = A + (B - A) * Alpha, element-wise
+     */
+    static void Lerp(TArrayView<const float> A, TArrayView<const float> B, float Alpha, TArrayView<float> Out);
+
+    /**
+     * Out = A + B * Scale, element-wise
+     */
+    static void AddScaled(TArrayView<const float> A, TArrayView<const float> B, float Scale, TArrayView<float> Out);
+
+    /**
+     * Out = A * Scale, element-wise
+     */
+    static void Scale(TArrayView<const float> A, float Scale, TArrayView<float> Out);
+
+    /**
+     * Normalize each packed vector, vectors too small to normalize become zero
+     */
+    static void Normalize(TArrayView<const float> Vectors, TArrayView<float> Out);
+
+    /**
+     * Write the distance from each packed vector to Point into OutDistances (one float per vector)
+     */
+    static void DistanceToPoint(TArrayView<const float> Vectors, const FVector3f& Point, TArrayView<float> OutDistances);
+
+    /**
+     * Transform each packed position by Matrix (row vector convention, as FMatrix::TransformPosition)
+     */
+    static void TransformPositions(TArrayView<const float> Vectors, const FMatrix44f& Matrix, TArrayView<float> Out);
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+
+/**
+ * Handle to a UObject as stored inside Lua userdata
+ * Holds the GUObjectArray index and serial number instead of a raw pointer (the same scheme FWeakObjectPtr uses),
+ * so a destroyed or garbage collected object resolves to nullptr instead of a dangling pointer
+ */
+struct FLuaObjectHandle
+{
+    /** Index of the object in GUObjectArray */
+    int32 ObjectIndex;
+
+    /** Serial number of the object at the time the handle was created */
+    int32 SerialNumber;
+
+    FLuaObjectHandle()
+        : ObjectIndex(INDEX_NONE)
+        , SerialNumber(0)
+    {
+    }
+
+    explicit FLuaObjectHandle(const UObject* Object)
+        : ObjectIndex(INDEX_NONE)
+        , SerialNumber(0)
+    {
+        if (Object)
+        {
+            ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+            SerialNumber = GUObjectArray.AllocateSerialNumber(ObjectIndex);
+        }
+    }
+
+    /**
+     * Resolve the handle back to its object
+     * Costs one array lookup and a serial number compare, no hashing
+     * @return The object, or nullptr if it has been destroyed, marked as garbage or its slot was reused
+     */
+    FORCEINLINE UObject* Resolve() const
+    {
+        if (ObjectIndex < 0)
+        {
+            return nullptr;
+        }
+
+        const FUObjectItem* Item = GUObjectArray.IndexToObject(ObjectIndex);
+        if (!Item || Item->GetSerialNumber() != SerialNumber || Item->IsUnreachable() || Item->IsGarbage())
+        {
+            return nullptr;
+        }
+
+        return static_cast<UObject*>(Item->Object);
+    }
+
+    FORCEINLINE bool operator==(const FLuaObjectHandle& Other) const
+    {
+        return ObjectIndex == Other.ObjectIndex && SerialNumber == Other.SerialNumber;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+struct lua_State;
+class FProperty;
+class UFunction;
+class UScriptStruct;
+
+/**
+ * Conversion of reflected property values to Lua values, used where the engine hands us raw parameter memory
+ * (delegate broadcasts) instead of typed C++ arguments
+ *
+ * Structs other than the UE value types are converted to plain tables through a layout plan that is built once per
+ * UScriptStruct: the converter of every field is resolved up front and the field names are interned once per Lua
+ * state, so converting a struct does no reflection lookups and hashes no strings. Game thread only, or from the
+ * scripts of a parallel tick
+ */
+class LUASCRIPTING_API FLuaPropertyMarshal
+{
+public:
+    /**
+     * Push the value of a property
+     * Supports booleans, numbers, enums, names, strings, texts, object references, the UE value types, containers
+     * (copied to tables) and structs made of those; other values are pushed as nil
+     * @param L The Lua state
+     * @param Property The property describing the value
+     * @param ValuePtr Pointer to the value (not to its container)
+     * @return True if the value type is supported
+     */
+    static bool PushProperty(lua_State* L, const FProperty* Property, const void* ValuePtr);
+
+    /**
+     * Write a Lua value to a property
+     * @param L The Lua state
+     * @param Index Stack index of the value
+     * @param Property The property describing the value
+     * @param ValuePtr Pointer to the value (not to its container)
+     * @return True if the Lua value could be converted, the property is left untouched otherwise
+     */
+    static bool ReadProperty(lua_State* L, int Index, const FProperty* Property, void* ValuePtr);
+
+    /**
+     * Push the input parameters of a function call, in declaration order
+     * @param L The Lua state
+     * @param Function The function (or delegate signature) describing the parameters
+     * @param Params The parameter memory
+     * @return Number of values pushed
+     */
+    static int PushParameters(lua_State* L, const UFunction* Function, const void* Params);
+
+    /**
+     * Push a struct as a table with one field per supported property
+     * @param L The Lua state
+     * @param Struct The struct type
+     * @param Data The struct memory
+     * @param OutIndex Stack index of a table to fill and push instead of creating one, 0 to create a new table
+     */
+    static void PushStruct(lua_State* L, const UScriptStruct* Struct, const void* Data, int OutIndex = 0);
+
+    /**
+     * Read the fields of a table into a struct; fields missing from the table keep their current value
+     * @param L The Lua state
+     * @param Index Stack index of the table
+     * @param Struct The struct type
+     * @param Data The struct memory
+     * @return True if the value at the index is a table
+     */
+    static bool ReadStruct(lua_State* L, int Index, const UScriptStruct* Struct, void* Data);
+
+    /**
+     * Typed helpers for USTRUCTs (FHitResult, FLinearColor, ...)
+     */
+    template<typename T>
+    static void PushStruct(lua_State* L, const T& Value, int OutIndex = 0)
+    {
+        PushStruct(L, TBaseStructure<T>::Get(), &Value, OutIndex);
+    }
+
+    template<typename T>
+    static bool ReadStruct(lua_State* L, int Index, T& OutValue)
+    {
+        return ReadStruct(L, Index, TBaseStructure<T>::Get(), &OutValue);
+    }
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "LuaScript.h"
+#include "LuaTickSubsystem.h"
 #include "LuaScriptComponent.generated.h"
 
 /**
@@ -32,6 +33,28 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lua")
     bool bCallTickFunction;
 
+    /**
+     * Tick the script together with all other scripts of the world (ULuaTickSubsystem) instead of through a tick
+     * function of its own; turn off to tick in this component's tick group or with its tick prerequisites
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lua|Advanced")
+    bool bUseBatchedTick;
+
+    /**
+     * Batched tick rates by distance to the nearest player view, closest first; beyond the last distance the last
+     * level applies. Empty to tick every frame. The level is picked again each time the script ticks
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lua|Advanced", meta = (EditCondition = "bUseBatchedTick"))
+    TArray<FLuaTickLODLevel> TickLODLevels;
+
+    /**
+     * Tick the script on a worker thread, concurrently with other scripts (lua.Tick.Parallel). Changes to the world
+     * made by the script are applied after all parallel scripts ticked and return nothing, and functions returning
+     * what they create (e.g. UE.Actor.SpawnActor) raise an error
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lua|Advanced", meta = (EditCondition = "bUseBatchedTick"))
+    bool bTickInParallel;
+
     /** Garbage collection frequency (how many frames between GC steps) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lua|Advanced", meta = (ClampMin = "1", UIMin = "1"))
     int32 GCInterval;
@@ -42,6 +65,15 @@ protected:
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
+    /** While the script is ticked by ULuaTickSubsystem, turns the batched tick on and off instead of the component's own tick function */
+    virtual void SetComponentTickEnabled(bool bEnabled) override;
+
+    /**
+     * Check whether the batched tick should call the script this frame
+     * @return False if the component is inactive, its batched tick is disabled or its owner's tick is disabled
+     */
+    bool ShouldTickBatched() const;
+
     /**
      * Execute the component's script
      * @param ErrorMessage Error message if execution fails
@@ -67,6 +99,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Lua|Development")
     bool HotReloadScript(FString& ErrorMessage);
 
+    /**
+     * Get the Lua state running the script, for native code working with the script's globals
+     * @return The state, or nullptr if the script is not running
+     */
+    struct lua_State* GetLuaState() const { return ComponentLuaState; }
+
 private:
     /** State to track if the script has been initialized */
     bool bScriptInitialized;
@@ -77,12 +115,21 @@ private:
     /** Frame counter for garbage collection */
     int32 GCCounter;
 
+    /** The script's tick is left to ULuaTickSubsystem, which only ticks it if it has a tick function */
+    bool bTickBatched;
+
+    /** Last value given to SetComponentTickEnabled while ticking batched */
+    bool bBatchedTickEnabled;
+
     /** Initialize the Lua environment for this component */
     bool InitializeLuaEnvironment(FString& ErrorMessage);
 
     /** Cleanup the Lua environment for this component */
     void CleanupLuaEnvironment();
 
+    /** Start ticking the script, batched or through the component's own tick function */
+    void RegisterTick();
+
     /** Determine script content to execute */
     FString DetermineScriptContent() const;
 
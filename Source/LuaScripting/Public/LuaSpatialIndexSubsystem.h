@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "UObject/ObjectKey.h"
+#include "LuaSpatialIndexSubsystem.generated.h"
+
+class AActor;
+class ULevel;
+
+/**
+ * Uniform grid over opt-in actors, backing the UE.World spatial queries
+ * Actors are tracked by class, by tag or individually; tracked actors are re-bucketed as their root component moves,
+ * so queries only visit the grid cells they overlap instead of every actor
+ */
+UCLASS()
+class LUASCRIPTING_API ULuaSpatialIndexSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /**
+     * Track all current and future actors of a class
+     * @param Class The actor class (subclasses are included)
+     * @return Number of existing actors that started being tracked
+     */
+    int32 TrackClass(UClass* Class);
+
+    /**
+     * Track all current and future actors with a tag
+     * Only tags present when the actor spawns, or when the tag is registered, are considered
+     * @param Tag The actor tag
+     * @return Number of existing actors that started being tracked
+     */
+    int32 TrackTag(FName Tag);
+
+    /**
+     * Track a single actor
+     * @param Actor The actor, it needs a root component
+     * @return True if the actor is tracked
+     */
+    bool TrackActor(AActor* Actor);
+
+    /**
+     * Stop tracking an actor
+     * @param Actor The actor
+     */
+    void UntrackActor(AActor* Actor);
+
+    /**
+     * Collect tracked actors within a radius
+     * @param Center Center of the sphere
+     * @param Radius Radius of the sphere
+     * @param OutActors Receives the actors (appended, unordered)
+     */
+    void QueryRadius(const FVector& Center, double Radius, TArray<AActor*>& OutActors) const;
+
+    /**
+     * Collect tracked actors inside a box
+     * @param Box The world space box
+     * @param OutActors Receives the actors (appended, unordered)
+     */
+    void QueryBox(const FBox& Box, TArray<AActor*>& OutActors) const;
+
+    /**
+     * Collect the tracked actors nearest to a point
+     * @param Center The point
+     * @param Count Maximum number of actors
+     * @param MaxRadius Actors further away are ignored
+     * @param OutActors Receives the actors, nearest first (appended)
+     */
+    void QueryNearest(const FVector& Center, int32 Count, double MaxRadius, TArray<AActor*>& OutActors) const;
+
+    /**
+     * Number of tracked actors
+     * @return The number of actors in the grid
+     */
+    int32 GetNumTracked() const { return EntryIds.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FEntry
+    {
+        TObjectKey<AActor> Key;
+        TWeakObjectPtr<AActor> Actor;
+        TWeakObjectPtr<USceneComponent> Root;
+        FDelegateHandle TransformHandle;
+
+        FVector Location = FVector::ZeroVector;
+        FIntVector Cell = FIntVector::ZeroValue;
+
+        // Position of the entry in its cell's array
+        int32 SlotInCell = INDEX_NONE;
+    };
+
+    /** Grid cell containing a location */
+    FIntVector ToCell(const FVector& Location) const;
+
+    /** Stop tracking an entry, its actor may already be gone */
+    void RemoveEntry(int32 EntryId);
+
+    void AddToCell(int32 EntryId);
+    void RemoveFromCell(int32 EntryId);
+
+    /** Call a function with the id and entry of every tracked actor whose location is inside a box */
+    template<typename FunctionType>
+    void ForEachInBox(const FBox& Box, FunctionType&& Function) const;
+
+    /** Whether an actor opted in through its class or tags */
+    bool ShouldTrack(const AActor* Actor) const;
+
+    void OnRootTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 EntryId);
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
+    void OnLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld);
+
+    // Edge length of a grid cell
+    double CellSize = 1000.0;
+
+    // Range of cells that ever held an actor, bounds nearest-neighbour searches
+    FIntVector MinCell = FIntVector::ZeroValue;
+    FIntVector MaxCell = FIntVector::ZeroValue;
+
+    TSparseArray<FEntry> Entries;
+    TMap<TObjectKey<AActor>, int32> EntryIds;
+    TMap<FIntVector, TArray<int32>> Cells;
+
+    // Opt-in rules
+    TSet<TObjectKey<UClass>> TrackedClasses;
+    TSet<FName> TrackedTags;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FDelegateHandle LevelRemovedHandle;
+};
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+// Forward declarations
+struct lua_State;
+struct FLuaStateContext;
+class AActor;
+class UWorld;
+
+/**
+ * Bulk actor spawning for UE.Actor.SpawnMany
+ * Actors are spawned in chunks, each chunk deferred-spawned first and then finished together; batches with a time
+ * budget are spread over several frames and resume the Lua coroutine that requested them when they are done
+ */
+class LUASCRIPTING_API FLuaSpawnScheduler
+{
+public:
+    /**
+     * Access the process-wide scheduler
+     * @return Reference to the singleton instance
+     */
+    static FLuaSpawnScheduler& Get();
+
+    /**
+     * Start processing queued batches once per frame
+     */
+    void Startup();
+
+    /**
+     * Stop processing and drop all queued batches
+     */
+    void Shutdown();
+
+    /**
+     * Spawn all actors of a batch immediately
+     * @param World The world to spawn into
+     * @param Class The actor class
+     * @param Transforms One transform per actor
+     * @param OutActors Receives the spawned actors (appended, failed spawns are skipped)
+     */
+    static void SpawnBatch(UWorld* World, UClass* Class, TConstArrayView<FTransform> Transforms, TArray<AActor*>& OutActors);
+
+    /**
+     * Queue a batch spawned over several frames; when it is done the table of spawned actors is passed to the
+     * coroutine as the result of its yield
+     * The batch is dropped without resuming the coroutine if its Lua state is reset or closed first
+     * @param Thread The coroutine that yields until the batch is done
+     * @param World The world to spawn into
+     * @param Class The actor class
+     * @param Transforms One transform per actor
+     * @param BudgetSeconds Time the batch may spend spawning per frame
+     * @return Id of the batch
+     */
+    uint32 Enqueue(lua_State* Thread, UWorld* World, UClass* Class, TArray<FTransform>&& Transforms, double BudgetSeconds);
+
+    /**
+     * Check whether a batch is still being spawned
+     * @param BatchId Id returned by Enqueue
+     * @return True if the batch has not finished yet
+     */
+    bool IsPending(uint32 BatchId) const;
+
+private:
+    FLuaSpawnScheduler() = default;
+
+    // Disallow copying and assignment
+    FLuaSpawnScheduler(const FLuaSpawnScheduler&) = delete;
+    FLuaSpawnScheduler& operator=(const FLuaSpawnScheduler&) = delete;
+
+    struct FBatch
+    {
+        uint32 Id = 0;
+
+        // Coroutine to resume and the registry reference keeping it alive
+        lua_State* Thread = nullptr;
+        int ThreadRef = 0;
+
+        FLuaStateContext* Context = nullptr;
+        FDelegateHandle ResetHandle;
+
+        TWeakObjectPtr<UWorld> World;
+        TWeakObjectPtr<UClass> Class;
+        TArray<FTransform> Transforms;
+        int32 NextIndex = 0;
+        double BudgetSeconds = 0.0;
+
+        TArray<TWeakObjectPtr<AActor>> Actors;
+
+        // Set when the batch's Lua state was reset before the batch finished
+        bool bCancelled = false;
+    };
+
+    /** Deferred-spawn a range of actors, then finish spawning all of them */
+    static void SpawnRange(UWorld* World, UClass* Class, TConstArrayView<FTransform> Transforms, TArray<AActor*>& OutActors);
+
+    /** Spawn the next chunk of a batch, returns false once the batch is complete */
+    static bool SpawnChunk(FBatch& Batch);
+
+    /** Hand the results to the coroutine and resume it */
+    static void Complete(FBatch& Batch);
+
+    /** Drop the batches of a Lua state that is being reset */
+    void OnContextReset(FLuaStateContext* Context);
+
+    bool Tick(float DeltaTime);
+
+    // Batches are heap allocated so they stay put while spawning runs scripts that queue more batches
+    TArray<TUniquePtr<FBatch>> Batches;
+    uint32 NextBatchId = 1;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
\ No newline at end of file
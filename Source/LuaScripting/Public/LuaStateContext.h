@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "LuaEventBus.h"
+
+// Forward declarations
+struct lua_State;
+class AActor;
+class UWorld;
+class ULuaScriptComponent;
+
+/**
+ * Native per-state data, reachable from any lua_State (including coroutines) through lua_getextraspace
+ * Bindings use it to find their owning component, actor and world in O(1) without touching Lua globals
+ * Created by FLuaStateManager together with the state and destroyed when the state is closed
+ */
+struct LUASCRIPTING_API FLuaStateContext
+{
+    /** Component running the script, if any */
+    TWeakObjectPtr<ULuaScriptComponent> Component;
+
+    /** Actor owning the component */
+    TWeakObjectPtr<AActor> Owner;
+
+    /** World the component lives in */
+    TWeakObjectPtr<UWorld> World;
+
+    /** Main thread of the state the context is attached to */
+    lua_State* MainThread = nullptr;
+
+    /** Handlers registered through UE.Event */
+    FLuaEventBus Events;
+
+    /** Broadcast when the context is reset, before the state is pooled again or closed; native work tied to the state must stop */
+    FSimpleMulticastDelegate OnReset;
+
+    /**
+     * Get the context of a Lua state
+     * @param L The Lua state (or one of its threads)
+     * @return The context, or nullptr if the state was not created by FLuaStateManager
+     */
+    static FLuaStateContext* Get(lua_State* L);
+
+    /**
+     * Attach a context to a newly created Lua state
+     * @param L The main thread of the Lua state
+     * @param Context The context to attach (nullptr to detach)
+     */
+    static void Attach(lua_State* L, FLuaStateContext* Context);
+
+    /**
+     * Bind the context to the component that runs the state
+     * @param InComponent The component
+     */
+    void Bind(ULuaScriptComponent* InComponent);
+
+    /**
+     * Clear everything bound to the context (called when the state returns to the pool or is closed)
+     */
+    void Reset();
+};
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "HAL/CriticalSection.h"
+#include "Containers/Ticker.h"
+#include "LuaEventPayload.h"
 
 // Forward declarations for Lua
 struct lua_State;
@@ -9,6 +11,9 @@ struct lua_State;
 // Define a proper logging category
 DECLARE_LOG_CATEGORY_EXTERN(LogLuaScripting, Log, All);
 
+// Stats group for the Lua runtime (stat LuaScripting)
+DECLARE_STATS_GROUP(TEXT("LuaScripting"), STATGROUP_LuaScripting, STATCAT_Advanced);
+
 /**
  * Manager class for Lua states in Unreal Engine
  * Handles creation, management, and destruction of Lua states
@@ -84,11 +89,49 @@ public:
      */
     void RunGarbageCollection(lua_State* State);
 
+    /**
+     * Queue an event for every Lua state with handlers for it, including the sender
+     * The values are encoded once and delivered together with the other broadcasts of the frame
+     * @param L The sending Lua state
+     * @param Event The event name
+     * @param FirstArg Stack index of the first value to send
+     * @param NumArgs Number of values
+     * @param OutError Receives the reason if the values can't be sent (static string)
+     * @return True if the event was queued
+     */
+    bool BroadcastEvent(lua_State* L, FName Event, int FirstArg, int NumArgs, const char*& OutError);
+
+    /**
+     * Record that a state has handlers for an event (called by FLuaEventBus)
+     * @param L The Lua state (or one of its threads)
+     * @param Event The event name
+     */
+    void AddEventSubscriber(lua_State* L, FName Event);
+
+    /**
+     * Record that a state no longer has handlers for an event (called by FLuaEventBus)
+     * @param L The Lua state (or one of its threads)
+     * @param Event The event name
+     */
+    void RemoveEventSubscriber(lua_State* L, FName Event);
+
 private:
     // Disallow copying and assignment
     FLuaStateManager(const FLuaStateManager&) = delete;
     FLuaStateManager& operator=(const FLuaStateManager&) = delete;
 
+    /**
+     * Create a Lua state with its native context attached
+     * @return The new state, or nullptr on failure
+     */
+    lua_State* CreateState();
+
+    /**
+     * Close a Lua state created by CreateState and destroy its context
+     * @param State The Lua state to close
+     */
+    void CloseState(lua_State* State);
+
     /**
      * Set up standard Lua libraries and UE-specific functions
      * @param State The Lua state to set up
@@ -110,6 +153,27 @@ private:
      */
     static int LuaErrorHandler(lua_State* State);
 
+    /**
+     * Deliver the broadcasts queued during the last frame
+     * @param DeltaTime Time since the last tick
+     * @return True to keep ticking
+     */
+    bool TickBroadcasts(float DeltaTime);
+
+    /**
+     * Decode a broadcast onto a subscriber's stack and trigger its handlers, run in protected mode
+     * @param State The subscriber's main thread
+     * @return 0
+     */
+    static int DeliverBroadcast(lua_State* State);
+
+    /** Event queued by BroadcastEvent, its values are a record of the frame's payload */
+    struct FPendingBroadcast
+    {
+        FName Event;
+        int32 PayloadOffset = 0;
+    };
+
 private:
     // Main Lua state
     lua_State* MainLuaState;
@@ -123,6 +187,20 @@ private:
     // Flag to track initialization state
     bool bIsInitialized;
 
+    // Main threads of the states with handlers, by event
+    TMap<FName, TSet<lua_State*>> EventSubscribers;
+
+    // Broadcasts of the current frame, and of the frame being delivered (swapped so neither reallocates)
+    TArray<FPendingBroadcast> PendingBroadcasts;
+    TArray<FPendingBroadcast> DeliveringBroadcasts;
+    FLuaEventPayload PendingPayload;
+    FLuaEventPayload DeliveringPayload;
+
+    // Subscribers of the broadcast being delivered
+    TArray<lua_State*> DeliveryTargets;
+
+    FTSTicker::FDelegateHandle BroadcastTickerHandle;
+
     // Maximum number of states to keep in the pool
     static constexpr int32 MaxPoolSize = 10;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+struct lua_State;
+
+/**
+ * Conversions between Lua strings and engine string types for the binding layer
+ * Lua strings are interned, so conversions that are repeated with the same strings (tags, names) are cached per
+ * Lua state instead of transcoding and hashing the string on every call. Conversions that cannot be cached go
+ * through thread-local scratch buffers instead of temporary allocations
+ */
+class LUASCRIPTING_API FLuaStringBridge
+{
+public:
+    /**
+     * Convert the string at the given stack index to an FName, raising a Lua error if it is not a string
+     * Results are cached in the state's registry, keyed by the Lua string itself
+     * @param L The Lua state
+     * @param Index The stack index
+     * @return The name
+     */
+    static FName ToName(lua_State* L, int Index);
+
+    /**
+     * Like ToName, but only finds names that already exist instead of adding new ones to the name table
+     * Meant for lookups with script provided strings (property and actor names)
+     * @param L The Lua state
+     * @param Index The stack index
+     * @return The name, or NAME_None if the string is not a string or no such name exists
+     */
+    static FName FindName(lua_State* L, int Index);
+
+    /**
+     * Push an FName as a Lua string
+     * The Lua strings are cached in the state's registry, keyed by the name, so pushing the same names again
+     * (object, class and tag names) neither transcodes nor allocates
+     * @param L The Lua state
+     * @param Name The name
+     */
+    static void PushName(lua_State* L, FName Name);
+
+    /**
+     * Push an engine string as a Lua string, transcoding through a thread-local buffer
+     * @param L The Lua state
+     * @param String The string
+     */
+    static void PushString(lua_State* L, FStringView String);
+
+    /**
+     * Convert the string at the given stack index to TCHARs, raising a Lua error if it is not a string
+     * @param L The Lua state
+     * @param Index The stack index
+     * @return Null terminated string in a thread-local buffer, valid until the next ToTCHAR call on this thread
+     */
+    static const TCHAR* ToTCHAR(lua_State* L, int Index);
+
+    /**
+     * Convert an engine string to UTF-8
+     * @param String The string
+     * @return Null terminated string in a thread-local buffer, valid until the next ToUTF8 or PushString call on
+     * this thread
+     */
+    static const char* ToUTF8(FStringView String);
+
+private:
+    // Entries kept per state and cache before the cache is dropped and rebuilt
+    static constexpr int32 MaxCachedNames = 4096;
+};
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LuaTickSubsystem.generated.h"
+
+// Forward declarations
+struct lua_State;
+class ULuaScriptComponent;
+
+/**
+ * Tick rate of a Lua script within a distance of the nearest player view
+ */
+USTRUCT(BlueprintType)
+struct FLuaTickLODLevel
+{
+    GENERATED_BODY()
+
+    /** Distance to the nearest player view up to which this level applies */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lua", meta = (ClampMin = "0"))
+    float MaxDistance = 0.0f;
+
+    /** Tick every N frames, 1 to tick every frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lua", meta = (ClampMin = "1", UIMin = "1"))
+    int32 FrameInterval = 1;
+
+    /** Minimum time between ticks in seconds, 0 to only use the frame interval */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lua", meta = (ClampMin = "0"))
+    float TimeInterval = 0.0f;
+};
+
+/**
+ * Calls the tick() functions of all Lua script components of a world in one loop
+ * Replaces one tick function per component in the tick graph. Each script's tick function is looked up once after
+ * the script and its init() ran and kept as a registry reference, and scripts without a tick function are not
+ * listed at all. Entries are kept sorted by Lua state so consecutive calls touch nearby memory
+ *
+ * Scripts with tick LOD levels tick less often the further their actor is from the nearest player view (or at the
+ * level picked by the significance handler) and receive the time since their last tick. When the frame's scripts
+ * take longer than lua.Tick.BudgetMs, the remaining scripts that are not at their first LOD level wait for a later
+ * frame; scripts at the first level always tick
+ *
+ * Scripts of components with bTickInParallel tick on task graph workers after the others, each in its own Lua state.
+ * Bindings that change the world are recorded per worker (FLuaCommandBuffer) and applied on the game thread once all
+ * of them are done, so every parallel script reads the world as it was when the parallel tick started
+ */
+UCLASS()
+class LUASCRIPTING_API ULuaTickSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * Start ticking a component's script, replacing an earlier registration of the component
+     * @param Component The component
+     * @param L The component's Lua state, after the script and init() ran
+     * @return True if the script has a tick function and was added
+     */
+    bool Register(ULuaScriptComponent* Component, lua_State* L);
+
+    /**
+     * Stop ticking a component's script; must be called before its Lua state is released
+     * @param Component The component
+     */
+    void Unregister(ULuaScriptComponent* Component);
+
+    /** Number of scripts being ticked */
+    int32 GetNumTicked() const { return NumLive; }
+
+    /**
+     * Returns the index into a component's TickLODLevels to use, clamped to the valid range
+     */
+    using FSignificanceHandler = TFunction<int32(const ULuaScriptComponent& Component)>;
+
+    /**
+     * Pick the LOD level of scripts with a game specific significance (e.g. a significance manager) instead of the
+     * distance to the nearest player view
+     * @param Handler The handler, an unbound function to restore distance based levels
+     */
+    void SetSignificanceHandler(FSignificanceHandler Handler);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FEntry
+    {
+        // Null once unregistered, the entry is removed after the current tick
+        ULuaScriptComponent* Component;
+        lua_State* State;
+
+        // Registry reference of the script's tick function
+        int TickRef;
+
+        // Frames since the last garbage collection step
+        int32 GCCounter;
+
+        // Ticked on a worker thread
+        bool bParallel;
+
+        // Time and frames since the last tick
+        float AccumulatedTime = 0.0f;
+        int32 FramesSinceTick = 0;
+
+        // Rate of the current LOD level, copied from the component so waiting entries don't touch it
+        int32 LODLevel = 0;
+        int32 FrameInterval = 1;
+        float TimeInterval = 0.0f;
+    };
+
+    /** Remove unregistered entries, restore the order by state and update the entry indices */
+    void Compact();
+
+    /** Collect the view locations of the world's local players */
+    void GatherViewLocations();
+
+    /** Pick the LOD level of an entry that just ticked */
+    void UpdateLOD(FEntry& Entry) const;
+
+    /** Tick the due parallel entries on workers and apply their recorded calls */
+    void TickParallel();
+
+    TArray<FEntry> Entries;
+    int32 NumLive = 0;
+
+    // Index of each registered component's entry
+    TMap<ULuaScriptComponent*, int32> EntryIndices;
+
+    // Entries are only nulled when unregistered (scripts may destroy other scripted actors while ticking) and
+    // removed at the start of the next tick
+    bool bNeedsCompact = false;
+
+    // Entry the next frame starts with, rotated past scripts that were deferred by the budget
+    int32 FirstEntry = 0;
+
+    FSignificanceHandler SignificanceHandler;
+
+    // View locations of the current frame
+    TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+    // Indices of the parallel entries due this frame
+    TArray<int32> ParallelEntries;
+
+    // States released while recorded calls are applied (by destroying scripted actors), their remaining calls are
+    // dropped
+    TSet<lua_State*> ReleasedStates;
+    bool bApplyingCommands = false;
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+struct lua_State;
+
+/**
+ * Native userdata value types for the UE math structs (FVector, FRotator, FQuat, FTransform)
+ * Values are stored inline in the userdata and expose fields, arithmetic metamethods and methods implemented in C++
+ */
+class LUASCRIPTING_API FLuaValueTypes
+{
+public:
+    /**
+     * Register the value type metatables and the UE.Vector/UE.Rotator/UE.Quat/UE.Transform constructors
+     * @param L The Lua state to register the types with (the UE table must already exist)
+     */
+    static void Register(lua_State* L);
+
+    /**
+     * Push a value type userdata to the Lua stack
+     * @param L The Lua state
+     * @param Value The value to push
+     */
+    static void PushVector(lua_State* L, const FVector& Value);
+    static void PushRotator(lua_State* L, const FRotator& Value);
+    static void PushQuat(lua_State* L, const FQuat& Value);
+    static void PushTransform(lua_State* L, const FTransform& Value);
+
+    /**
+     * Push a value into an existing value type userdata or table, for getters taking an optional destination
+     * The userdata at OutIndex is overwritten, or the table's named fields (X, Y, Z, ...) are set, and it is pushed
+     * again, so per-frame reads create no garbage; a new value is pushed if nothing (or nil) was passed at OutIndex,
+     * anything else raises a Lua error
+     * @param L The Lua state
+     * @param Value The value to push
+     * @param OutIndex Stack index of the destination, 0 for none
+     */
+    static void PushVector(lua_State* L, const FVector& Value, int OutIndex);
+    static void PushRotator(lua_State* L, const FRotator& Value, int OutIndex);
+    static void PushQuat(lua_State* L, const FQuat& Value, int OutIndex);
+    static void PushTransform(lua_State* L, const FTransform& Value, int OutIndex);
+
+    /**
+     * Get a pointer to the value stored in a value type userdata
+     * @param L The Lua state
+     * @param Index The stack index
+     * @return Pointer to the value inside the userdata, or nullptr if the value is not of that type
+     */
+    static FVector* ToVectorUserdata(lua_State* L, int Index);
+    static FRotator* ToRotatorUserdata(lua_State* L, int Index);
+    static FQuat* ToQuatUserdata(lua_State* L, int Index);
+    static FTransform* ToTransformUserdata(lua_State* L, int Index);
+
+    /**
+     * Read a value from the Lua stack
+     * Accepts the matching userdata as well as legacy tables ({X, Y, Z} and {Pitch, Yaw, Roll})
+     * @param L The Lua state
+     * @param Index The stack index
+     * @param OutValue Receives the value on success
+     * @return True if the value at the index could be converted
+     */
+    static bool GetVector(lua_State* L, int Index, FVector& OutValue);
+    static bool GetRotator(lua_State* L, int Index, FRotator& OutValue);
+    static bool GetQuat(lua_State* L, int Index, FQuat& OutValue);
+    static bool GetTransform(lua_State* L, int Index, FTransform& OutValue);
+
+    /**
+     * Read a value from the Lua stack, raising a Lua error if it cannot be converted
+     * @param L The Lua state
+     * @param Index The stack index
+     * @return The converted value
+     */
+    static FVector CheckVector(lua_State* L, int Index);
+    static FRotator CheckRotator(lua_State* L, int Index);
+    static FQuat CheckQuat(lua_State* L, int Index);
+    static FTransform CheckTransform(lua_State* L, int Index);
+};
\ No newline at end of file